@@ -0,0 +1,297 @@
+/**
+ * @file apiloadtest.cpp
+ * @brief Local HTTP API load test client.
+ *
+ * Opens a number of keep-alive connections to a running API server (started
+ * with --serve or --api-port) and sends requests for random verses over each
+ * connection for the given duration, one request in flight per connection.
+ * Prints the throughput and latency percentiles and writes them as JSON.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTcpSocket>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief number of verses in each surah, used to pick random verses
+ */
+static const int s_verseCounts[114] = {
+  7,   286, 200, 176, 120, 165, 206, 75,  129, 109, 123, 111, 43,  52,  99,
+  128, 111, 110, 98,  135, 112, 78,  118, 64,  77,  227, 93,  88,  69,  60,
+  34,  30,  73,  54,  45,  83,  182, 88,  75,  85,  54,  53,  89,  59,  37,
+  35,  38,  29,  18,  45,  60,  49,  62,  55,  78,  96,  29,  22,  24,  13,
+  14,  11,  11,  18,  12,  12,  30,  52,  52,  44,  28,  28,  20,  56,  40,
+  31,  50,  40,  46,  42,  29,  19,  36,  25,  22,  17,  19,  26,  30,  20,
+  15,  21,  11,  8,   8,   19,  5,   8,   8,   11,  11,  8,   3,   9,   5,
+  4,   7,   3,   6,   3,   5,   4,   5,   6
+};
+
+/**
+ * @brief LoadTest class drives the connections of the load test
+ */
+class LoadTest : public QObject
+{
+public:
+  /**
+   * @brief class constructor
+   * @param host - server address
+   * @param port - server port
+   * @param endpoint - endpoint requested, 'mixed' for a mix of all endpoints
+   * @param translation - translation id used in translation requests
+   * @param tafsir - tafsir id used in tafsir requests
+   */
+  LoadTest(const QString& host,
+           quint16 port,
+           const QString& endpoint,
+           const QString& translation,
+           const QString& tafsir)
+    : m_host(host)
+    , m_port(port)
+    , m_endpoint(endpoint)
+    , m_translation(translation)
+    , m_tafsir(tafsir)
+  {
+  }
+  /**
+   * @brief run the load test, blocks until all the connections are done
+   * @param connections - number of concurrent connections
+   * @param seconds - test duration
+   * @param warmup - seconds of requests excluded from the results
+   */
+  void run(int connections, int seconds, int warmup)
+  {
+    m_warmupMs = warmup * 1000;
+    m_durationMs = (warmup + seconds) * 1000;
+    m_running = connections;
+    m_clock.start();
+    for (int i = 0; i < connections; i++)
+      connectSocket();
+
+    QEventLoop loop;
+    m_loop = &loop;
+    loop.exec();
+    m_measuredMs = m_clock.elapsed() - m_warmupMs;
+  }
+  /**
+   * @brief summarize the results
+   * @return QJsonObject of the request count, throughput and latency
+   * percentiles in microseconds
+   */
+  QJsonObject summary()
+  {
+    std::sort(m_latencies.begin(), m_latencies.end());
+    QJsonObject obj;
+    obj["requests"] = m_latencies.size();
+    obj["errors"] = m_errors;
+    obj["cache_hits"] = m_cacheHits;
+    obj["seconds"] = m_measuredMs / 1000.0;
+    obj["requests_per_second"] =
+      m_latencies.size() * 1000.0 / std::max<qint64>(1, m_measuredMs);
+    if (m_latencies.isEmpty())
+      return obj;
+
+    for (int p : { 50, 90, 99 }) {
+      qsizetype idx = qsizetype(std::ceil(p / 100.0 * m_latencies.size())) - 1;
+      obj["p" + QString::number(p) + "_us"] =
+        m_latencies.at(std::clamp<qsizetype>(idx, 0, m_latencies.size() - 1)) /
+        1000.0;
+    }
+    obj["max_us"] = m_latencies.last() / 1000.0;
+    return obj;
+  }
+
+private:
+  /**
+   * @brief Connection struct holds the state of a single connection
+   */
+  struct Connection
+  {
+    QByteArray buffer;
+    qint64 sentNs = 0;
+  };
+  void connectSocket()
+  {
+    QTcpSocket* socket = new QTcpSocket(this);
+    Connection* conn = new Connection;
+    connect(socket, &QTcpSocket::connected, this, [this, socket, conn]() {
+      send(socket, conn);
+    });
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket, conn]() {
+      receive(socket, conn);
+    });
+    connect(socket, &QTcpSocket::errorOccurred, this, [this, socket, conn]() {
+      QTextStream(stderr) << "connection error: " << socket->errorString()
+                          << Qt::endl;
+      m_errors++;
+      done(socket, conn);
+    });
+    socket->connectToHost(m_host, m_port);
+  }
+  QByteArray target()
+  {
+    QRandomGenerator* rng = QRandomGenerator::global();
+    int surah = rng->bounded(1, 115);
+    int verse = rng->bounded(1, s_verseCounts[surah - 1] + 1);
+    QString endpoint = m_endpoint;
+    if (endpoint == "mixed") {
+      static const char* endpoints[] = { "verse", "glyphs", "translation",
+                                         "tafsir", "page" };
+      endpoint = endpoints[rng->bounded(5)];
+    }
+
+    QString query = QString("surah=%0&verse=%1").arg(surah).arg(verse);
+    if (endpoint == "translation")
+      query += "&id=" + m_translation;
+    else if (endpoint == "tafsir")
+      query += "&id=" + m_tafsir;
+    else if (endpoint == "page")
+      query = "page=" + QString::number(rng->bounded(1, 605));
+
+    return ("/api/" + endpoint + '?' + query).toUtf8();
+  }
+  void send(QTcpSocket* socket, Connection* conn)
+  {
+    if (m_clock.elapsed() >= m_durationMs) {
+      done(socket, conn);
+      return;
+    }
+
+    conn->sentNs = m_clock.nsecsElapsed();
+    socket->write("GET " + target() + " HTTP/1.1\r\nHost: " +
+                  m_host.toUtf8() + "\r\nConnection: keep-alive\r\n\r\n");
+  }
+  void receive(QTcpSocket* socket, Connection* conn)
+  {
+    conn->buffer.append(socket->readAll());
+    qsizetype end = conn->buffer.indexOf("\r\n\r\n");
+    if (end == -1)
+      return;
+
+    QByteArray head = conn->buffer.left(end);
+    qsizetype lengthIdx = head.toLower().indexOf("content-length:");
+    qsizetype length =
+      head.mid(lengthIdx + 15, head.indexOf('\r', lengthIdx) - lengthIdx - 15)
+        .trimmed()
+        .toLongLong();
+    if (conn->buffer.size() < end + 4 + length)
+      return;
+
+    conn->buffer.remove(0, end + 4 + length);
+    if (conn->sentNs / 1000000 >= m_warmupMs) {
+      m_latencies.append(m_clock.nsecsElapsed() - conn->sentNs);
+      if (!head.startsWith("HTTP/1.1 200"))
+        m_errors++;
+      if (head.contains("X-Cache: HIT"))
+        m_cacheHits++;
+    }
+
+    send(socket, conn);
+  }
+  void done(QTcpSocket* socket, Connection* conn)
+  {
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+    delete conn;
+    if (--m_running == 0)
+      m_loop->quit();
+  }
+  const QString m_host;
+  const quint16 m_port;
+  const QString m_endpoint;
+  const QString m_translation;
+  const QString m_tafsir;
+  QElapsedTimer m_clock;
+  QEventLoop* m_loop = nullptr;
+  qint64 m_warmupMs = 0;
+  qint64 m_durationMs = 0;
+  qint64 m_measuredMs = 0;
+  int m_running = 0;
+  int m_errors = 0;
+  int m_cacheHits = 0;
+  QList<qint64> m_latencies;
+};
+
+/**
+ * @brief load test entry point
+ */
+int
+main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Load test the local HTTP API.");
+  parser.addHelpOption();
+  QCommandLineOption hostOpt("host", "Server address.", "host", "127.0.0.1");
+  QCommandLineOption portOpt("port", "Server port.", "port", "8750");
+  QCommandLineOption connectionsOpt(
+    "connections", "Concurrent keep-alive connections.", "count", "32");
+  QCommandLineOption durationOpt(
+    "duration", "Measured duration in seconds.", "seconds", "10");
+  QCommandLineOption warmupOpt(
+    "warmup", "Warmup duration in seconds.", "seconds", "2");
+  QCommandLineOption endpointOpt(
+    "endpoint",
+    "Endpoint to request: verse, glyphs, translation, tafsir, page or mixed.",
+    "endpoint",
+    "mixed");
+  QCommandLineOption translationOpt(
+    "translation", "Translation id.", "id", "muyassar");
+  QCommandLineOption tafsirOpt("tafsir", "Tafsir id.", "id", "sa3dy");
+  QCommandLineOption outputOpt(
+    "output", "JSON output file.", "path", "api-loadtest.json");
+  parser.addOptions({ hostOpt,
+                      portOpt,
+                      connectionsOpt,
+                      durationOpt,
+                      warmupOpt,
+                      endpointOpt,
+                      translationOpt,
+                      tafsirOpt,
+                      outputOpt });
+  parser.process(app);
+
+  LoadTest test(parser.value(hostOpt),
+                parser.value(portOpt).toUShort(),
+                parser.value(endpointOpt),
+                parser.value(translationOpt),
+                parser.value(tafsirOpt));
+  test.run(std::max(1, parser.value(connectionsOpt).toInt()),
+           std::max(1, parser.value(durationOpt).toInt()),
+           std::max(0, parser.value(warmupOpt).toInt()));
+
+  QJsonObject report = test.summary();
+  report["endpoint"] = parser.value(endpointOpt);
+  report["connections"] = parser.value(connectionsOpt).toInt();
+
+  QTextStream out(stdout);
+  out << report["requests"].toInteger() << " requests in "
+      << report["seconds"].toDouble() << "s, "
+      << report["requests_per_second"].toDouble() << " req/s, "
+      << report["errors"].toInt() << " errors, "
+      << report["cache_hits"].toInt() << " cache hits" << Qt::endl;
+  out << "latency p50 " << report["p50_us"].toDouble() << "us  p90 "
+      << report["p90_us"].toDouble() << "us  p99 "
+      << report["p99_us"].toDouble() << "us  max "
+      << report["max_us"].toDouble() << "us" << Qt::endl;
+
+  QFile file(parser.value(outputOpt));
+  if (!file.open(QIODevice::WriteOnly)) {
+    QTextStream(stderr) << "couldn't write " << file.fileName() << Qt::endl;
+    return 1;
+  }
+  file.write(QJsonDocument(report).toJson());
+  out << "results written to " << file.fileName() << Qt::endl;
+
+  return report["errors"].toInt() == 0 ? 0 : 1;
+}
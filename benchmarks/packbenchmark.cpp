@@ -0,0 +1,266 @@
+/**
+ * @file packbenchmark.cpp
+ * @brief Recitation pack benchmark.
+ *
+ * Copies the complete surahs of a reciter to a temporary directory, then loads
+ * every verse in a QMediaPlayer from the loose verse files and from the
+ * surah packs, the way VersePlayer does on a verse transition. Prints the
+ * load latency percentiles and the disk footprint of both layouts and writes
+ * them as JSON. The downloaded files are never modified.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMediaPlayer>
+#include <QStorageInfo>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+#include <player/recitationpack.h>
+#include <types/verse.h>
+#include <utils/appinfo.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @brief time loading a source in the player until it is ready to play
+ * @param player - QMediaPlayer to load the source in
+ * @param load - function setting the player source
+ * @return load latency in microseconds, -1 if the media couldn't be loaded
+ */
+template<typename Fn>
+static double
+measureLoad(QMediaPlayer& player, Fn load)
+{
+  QEventLoop loop;
+  QTimer timeout;
+  timeout.setSingleShot(true);
+  QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+  QObject::connect(&player,
+                   &QMediaPlayer::mediaStatusChanged,
+                   &loop,
+                   [&loop](QMediaPlayer::MediaStatus status) {
+                     if (status == QMediaPlayer::LoadedMedia ||
+                         status == QMediaPlayer::InvalidMedia)
+                       loop.quit();
+                   });
+
+  QElapsedTimer timer;
+  timer.start();
+  load();
+  if (player.mediaStatus() != QMediaPlayer::LoadedMedia) {
+    timeout.start(5000);
+    loop.exec();
+  }
+
+  qint64 nsecs = timer.nsecsElapsed();
+  QObject::disconnect(&player, nullptr, &loop, nullptr);
+  if (player.mediaStatus() != QMediaPlayer::LoadedMedia)
+    return -1;
+
+  return nsecs / 1000.0;
+}
+
+/**
+ * @brief summarize the collected latencies
+ * @param samples - latencies in microseconds
+ * @return QJsonObject with the sample count and latency percentiles
+ */
+static QJsonObject
+summary(QList<double> samples)
+{
+  std::sort(samples.begin(), samples.end());
+  QJsonObject obj;
+  obj["samples"] = samples.size();
+  if (samples.isEmpty())
+    return obj;
+
+  for (int p : { 50, 90, 99 }) {
+    qsizetype idx = qsizetype(std::ceil(p / 100.0 * samples.size())) - 1;
+    obj["p" + QString::number(p) + "_us"] =
+      samples.at(std::clamp<qsizetype>(idx, 0, samples.size() - 1));
+  }
+  obj["max_us"] = samples.last();
+
+  return obj;
+}
+
+/**
+ * @brief compute the disk footprint of the given files
+ * @param files - absolute file paths
+ * @param blockSize - allocation unit of the file system
+ * @return QJsonObject with the file count, the data size and the size
+ * allocated on disk
+ */
+static QJsonObject
+footprint(const QStringList& files, qint64 blockSize)
+{
+  qint64 bytes = 0, allocated = 0;
+  for (const QString& file : files) {
+    qint64 size = QFileInfo(file).size();
+    bytes += size;
+    allocated += (size + blockSize - 1) / blockSize * blockSize;
+  }
+
+  QJsonObject obj;
+  obj["files"] = files.size();
+  obj["bytes"] = bytes;
+  obj["allocated_bytes"] = allocated;
+  return obj;
+}
+
+/**
+ * @brief print a human readable line for the given summary
+ * @param out - QTextStream to print to
+ * @param name - layout name
+ * @param latency - QJsonObject returned from summary()
+ * @param disk - QJsonObject returned from footprint()
+ */
+static void
+printSummary(QTextStream& out,
+             const QString& name,
+             const QJsonObject& latency,
+             const QJsonObject& disk)
+{
+  out << name.leftJustified(8) << " load p50 " << latency["p50_us"].toDouble()
+      << "us  p90 " << latency["p90_us"].toDouble() << "us  p99 "
+      << latency["p99_us"].toDouble() << "us  files "
+      << disk["files"].toInteger() << "  on disk "
+      << disk["allocated_bytes"].toInteger() / 1024 << " KB" << Qt::endl;
+}
+
+/**
+ * @brief benchmark entry point
+ */
+int
+main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  AppInfo::apply();
+
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  QCommandLineOption reciterOpt(
+    "reciter", "Reciter directory name.", "reciter", "Al-Husary");
+  QCommandLineOption surahsOpt("surahs", "Surah range.", "range", "1-114");
+  QCommandLineOption outputOpt(
+    "output", "JSON output file.", "path", "pack-benchmark.json");
+  parser.addOptions({ reciterOpt, surahsOpt, outputOpt });
+  parser.process(app);
+
+  QTextStream out(stdout);
+  QTextStream err(stderr);
+  QStringList range = parser.value(surahsOpt).split('-');
+  int first = std::clamp(range.first().toInt(), 1, 114);
+  int last = std::clamp(range.last().toInt(), first, 114);
+
+  QDir source(DirManager::getInstance().downloadsDir().absoluteFilePath(
+    "recitations/" + parser.value(reciterOpt)));
+  QTemporaryDir tmp;
+  QDir loose(tmp.filePath("loose")), packed(tmp.filePath("packed"));
+  QDir().mkpath(loose.path());
+  QDir().mkpath(packed.path());
+
+  // only complete surahs can be packed
+  QList<int> surahs;
+  QStringList looseFiles, packFiles;
+  for (int surah = first; surah <= last; surah++) {
+    QStringList files;
+    for (int verse = 1; verse <= Verse::surahVerseCount(surah); verse++) {
+      QString file = QString::number(surah).rightJustified(3, '0') +
+                     QString::number(verse).rightJustified(3, '0') + ".mp3";
+      if (!source.exists(file))
+        break;
+      files.append(file);
+    }
+    if (files.size() != Verse::surahVerseCount(surah))
+      continue;
+
+    for (const QString& file : files) {
+      QFile::copy(source.filePath(file), loose.filePath(file));
+      QFile::copy(source.filePath(file), packed.filePath(file));
+      looseFiles.append(loose.filePath(file));
+    }
+    if (!RecitationPack::pack(packed, surah)) {
+      err << "couldn't pack surah " << surah << Qt::endl;
+      return 1;
+    }
+
+    packFiles.append(packed.filePath(RecitationPack::fileName(surah)));
+    surahs.append(surah);
+  }
+
+  if (surahs.isEmpty()) {
+    err << "no complete surahs found in " << source.path() << Qt::endl;
+    return 1;
+  }
+
+  QMediaPlayer player;
+  QList<double> looseLoads, packedLoads;
+  QIODevice* device = nullptr;
+  for (int surah : surahs) {
+    for (int verse = 1; verse <= Verse::surahVerseCount(surah); verse++) {
+      QString file = QString::number(surah).rightJustified(3, '0') +
+                     QString::number(verse).rightJustified(3, '0') + ".mp3";
+      double us = measureLoad(player, [&]() {
+        player.setSource(QUrl::fromLocalFile(loose.filePath(file)));
+      });
+      if (us >= 0)
+        looseLoads.append(us);
+
+      QString packPath = packed.filePath(RecitationPack::fileName(surah));
+      us = measureLoad(player, [&]() {
+        QIODevice* previous = device;
+        device = RecitationPack::openSource(
+          RecitationPack::verseSource(packPath, verse), &player);
+        player.setSourceDevice(device, QUrl("verse.mp3"));
+        delete previous;
+      });
+      if (us >= 0)
+        packedLoads.append(us);
+    }
+  }
+
+  qint64 blockSize = std::max(1, QStorageInfo(tmp.path()).blockSize());
+  QJsonObject looseResult, packedResult;
+  looseResult["load"] = summary(looseLoads);
+  looseResult["disk"] = footprint(looseFiles, blockSize);
+  packedResult["load"] = summary(packedLoads);
+  packedResult["disk"] = footprint(packFiles, blockSize);
+
+  out << surahs.size() << " surahs, " << looseFiles.size() << " verses of "
+      << parser.value(reciterOpt) << Qt::endl;
+  printSummary(out,
+               "loose",
+               looseResult["load"].toObject(),
+               looseResult["disk"].toObject());
+  printSummary(out,
+               "packed",
+               packedResult["load"].toObject(),
+               packedResult["disk"].toObject());
+
+  QJsonObject report;
+  report["version"] = QCoreApplication::applicationVersion();
+  report["reciter"] = parser.value(reciterOpt);
+  report["surahs"] = surahs.size();
+  report["block_size"] = blockSize;
+  report["loose"] = looseResult;
+  report["packed"] = packedResult;
+
+  QFile file(parser.value(outputOpt));
+  if (!file.open(QIODevice::WriteOnly)) {
+    err << "couldn't write " << file.fileName() << Qt::endl;
+    return 1;
+  }
+  file.write(QJsonDocument(report).toJson());
+  out << "results written to " << file.fileName() << Qt::endl;
+
+  return 0;
+}
@@ -0,0 +1,330 @@
+/**
+ * @file pagebenchmark.cpp
+ * @brief Page rendering benchmark.
+ *
+ * Times QuranPageBrowser::constructPage, highlightVerse, bestFitFontSize and
+ * surahFrame for every page in each combination of QCF version, theme and
+ * font size. Every QCF version & theme combination runs in its own process
+ * since the configuration is loaded once per process, the parent process
+ * collects the results, prints a summary and writes them as JSON.
+ */
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <service/servicefactory.h>
+#include <utils/appinfo.h>
+#include <utils/dirmanager.h>
+#include <utils/fontmanager.h>
+#include <utils/stylemanager.h>
+#include <widgets/quranpagebrowser.h>
+
+/**
+ * @brief number of heap allocations done by the process
+ */
+static std::atomic<quint64> s_allocations{ 0 };
+
+void*
+operator new(std::size_t size)
+{
+  s_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+/**
+ * @brief Samples class collects the latency and allocation count of each run
+ * of a benchmarked function
+ */
+class Samples
+{
+public:
+  /**
+   * @brief time a single run of the given function
+   * @param fn - function to run
+   */
+  template<typename Fn>
+  void measure(Fn fn)
+  {
+    quint64 allocations = s_allocations.load(std::memory_order_relaxed);
+    QElapsedTimer timer;
+    timer.start();
+    fn();
+    m_nsecs.append(timer.nsecsElapsed());
+    m_allocations.append(s_allocations.load(std::memory_order_relaxed) -
+                         allocations);
+  }
+  /**
+   * @brief summarize the collected samples
+   * @return QJsonObject with the sample count, latency percentiles in
+   * microseconds and allocation percentiles
+   */
+  QJsonObject summary() const
+  {
+    QList<qint64> nsecs = m_nsecs;
+    QList<quint64> allocations = m_allocations;
+    std::sort(nsecs.begin(), nsecs.end());
+    std::sort(allocations.begin(), allocations.end());
+
+    QJsonObject obj;
+    obj["samples"] = nsecs.size();
+    if (nsecs.isEmpty())
+      return obj;
+
+    for (int p : { 50, 90, 99 }) {
+      obj["p" + QString::number(p) + "_us"] = percentile(nsecs, p) / 1000.0;
+      obj["allocs_p" + QString::number(p)] =
+        qint64(percentile(allocations, p));
+    }
+    obj["max_us"] = nsecs.last() / 1000.0;
+    obj["mean_us"] =
+      std::accumulate(nsecs.cbegin(), nsecs.cend(), qint64(0)) /
+      nsecs.size() / 1000.0;
+
+    return obj;
+  }
+
+private:
+  template<typename T>
+  static T percentile(const QList<T>& sorted, int p)
+  {
+    qsizetype idx = qsizetype(std::ceil(p / 100.0 * sorted.size())) - 1;
+    return sorted.at(std::clamp<qsizetype>(idx, 0, sorted.size() - 1));
+  }
+  QList<qint64> m_nsecs;
+  QList<quint64> m_allocations;
+};
+
+/**
+ * @brief run the benchmark for a single QCF version & theme, called in the
+ * child process
+ * @param qcf - QCF version (1 or 2)
+ * @param dark - boolean indicating whether to use the dark theme
+ * @param sizes - page font sizes to benchmark
+ * @param first - first page
+ * @param last - last page
+ * @return QJsonObject of the variant results
+ */
+static QJsonObject
+runVariant(int qcf, bool dark, const QList<int>& sizes, int first, int last)
+{
+  QJsonObject variant;
+  variant["qcf"] = qcf;
+  variant["dark"] = dark;
+
+  // the configuration is read from a temporary file to keep the user
+  // settings untouched
+  QTemporaryDir configDir;
+  DirManager::getInstance().setConfigDir(QDir(configDir.path()));
+  QSettings conf(QDir(configDir.path()).filePath("qurancompanion.conf"),
+                 QSettings::IniFormat);
+  conf.setValue("Theme", dark ? 2 : 0);
+  conf.setValue("Reader/QCF", qcf);
+  conf.setValue("Reader/AdaptiveFont", false);
+  conf.sync();
+
+  StyleManager::getInstance().loadTheme();
+  FontManager::getInstance().loadFonts();
+  if (qcf == 2 && !FontManager::getInstance().qcfExists()) {
+    variant["skipped"] = "QCF v2 fonts are not downloaded";
+    return variant;
+  }
+
+  const QuranService* quranService = ServiceFactory::quranService();
+  const GlyphService* glyphService = ServiceFactory::glyphService();
+  QWidget host;
+  host.resize(1280, 1000);
+  QuranPageBrowser browser(&host, first);
+  browser.resize(host.size());
+
+  Samples frames;
+  for (int surah = 1; surah <= 114; surah++) {
+    QString glyph = glyphService->getSurahNameGlyph(surah);
+    frames.measure([&]() { browser.surahFrame(glyph); });
+  }
+  variant["surahFrame"] = frames.summary();
+
+  QJsonArray runs;
+  for (int size : sizes) {
+    Configuration::getInstance().settings().setValue(
+      "Reader/QCF" + QString::number(qcf) + "Size", size);
+    browser.updateFontSize();
+
+    Samples construct, highlight, bestFit;
+    for (int page = first; page <= last; page++) {
+      construct.measure([&]() { browser.constructPage(page, true); });
+      bestFit.measure([&]() { browser.bestFitFontSize(); });
+
+      int verses = quranService->verseInfoList(page).size();
+      for (int i = 0; i < verses; i++)
+        highlight.measure([&]() { browser.highlightVerse(i); });
+
+      // neighbour page fonts are registered through the event loop
+      QCoreApplication::processEvents();
+    }
+
+    QJsonObject run;
+    run["fontSize"] = size;
+    run["constructPage"] = construct.summary();
+    run["highlightVerse"] = highlight.summary();
+    run["bestFitFontSize"] = bestFit.summary();
+    runs.append(run);
+  }
+
+  variant["runs"] = runs;
+  return variant;
+}
+
+/**
+ * @brief print a human readable line for the given summary
+ * @param out - QTextStream to print to
+ * @param name - benchmarked function name
+ * @param summary - QJsonObject returned from Samples::summary
+ */
+static void
+printSummary(QTextStream& out, const QString& name, const QJsonObject& summary)
+{
+  out << "  " << name.leftJustified(16) << " p50 "
+      << summary["p50_us"].toDouble() << "us  p90 "
+      << summary["p90_us"].toDouble() << "us  p99 "
+      << summary["p99_us"].toDouble() << "us  allocs p50 "
+      << summary["allocs_p50"].toInteger() << Qt::endl;
+}
+
+/**
+ * @brief benchmark entry point
+ * @details without --variant, the benchmark runs itself for each QCF version
+ * & theme combination, collects the output of each run and writes the
+ * results to the JSON output file
+ */
+int
+main(int argc, char* argv[])
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QApplication app(argc, argv);
+  AppInfo::apply();
+
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  QCommandLineOption variantOpt("variant", "Run a single variant.");
+  QCommandLineOption qcfOpt("qcf", "QCF version of the variant.", "qcf", "1");
+  QCommandLineOption darkOpt("dark", "Use the dark theme in the variant.");
+  QCommandLineOption sizesOpt(
+    "sizes", "Comma separated page font sizes.", "sizes", "16,22,28");
+  QCommandLineOption pagesOpt("pages", "Page range.", "range", "1-604");
+  QCommandLineOption outputOpt(
+    "output", "JSON output file.", "path", "page-benchmark.json");
+  parser.addOptions(
+    { variantOpt, qcfOpt, darkOpt, sizesOpt, pagesOpt, outputOpt });
+  parser.process(app);
+
+  QStringList range = parser.value(pagesOpt).split('-');
+  int first = std::clamp(range.first().toInt(), 1, 604);
+  int last = std::clamp(range.last().toInt(), first, 604);
+
+  if (parser.isSet(variantOpt)) {
+    QList<int> sizes;
+    for (const QString& size : parser.value(sizesOpt).split(','))
+      sizes.append(size.toInt());
+
+    QJsonObject variant = runVariant(parser.value(qcfOpt).toInt(),
+                                     parser.isSet(darkOpt),
+                                     sizes,
+                                     first,
+                                     last);
+    QTextStream(stdout) << QJsonDocument(variant).toJson(QJsonDocument::Compact)
+                        << Qt::endl;
+    return 0;
+  }
+
+  QTextStream out(stdout);
+  QJsonArray variants;
+  for (int qcf : { 1, 2 }) {
+    for (bool dark : { false, true }) {
+      QStringList args{ "--variant",
+                        "--qcf",
+                        QString::number(qcf),
+                        "--sizes",
+                        parser.value(sizesOpt),
+                        "--pages",
+                        parser.value(pagesOpt) };
+      if (dark)
+        args.append("--dark");
+
+      QProcess child;
+      child.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+      child.start(QCoreApplication::applicationFilePath(), args);
+      child.waitForFinished(-1);
+
+      QByteArray output = child.readAllStandardOutput().trimmed();
+      QJsonObject variant =
+        QJsonDocument::fromJson(output.split('\n').last()).object();
+      if (child.exitCode() != 0 || variant.isEmpty()) {
+        QTextStream(stderr) << "variant qcf" << qcf << (dark ? " dark" : "")
+                            << " failed" << Qt::endl;
+        return 1;
+      }
+
+      out << "QCF v" << qcf << (dark ? " dark" : "") << Qt::endl;
+      if (variant.contains("skipped")) {
+        out << "  skipped: " << variant["skipped"].toString() << Qt::endl;
+      } else {
+        printSummary(out, "surahFrame", variant["surahFrame"].toObject());
+        for (const QJsonValue& run : variant["runs"].toArray()) {
+          QJsonObject obj = run.toObject();
+          out << " font size " << obj["fontSize"].toInt() << Qt::endl;
+          for (const QString& fn :
+               { "constructPage", "highlightVerse", "bestFitFontSize" })
+            printSummary(out, fn, obj[fn].toObject());
+        }
+      }
+
+      variants.append(variant);
+    }
+  }
+
+  QJsonObject report;
+  report["version"] = QApplication::applicationVersion();
+  report["pages"] = parser.value(pagesOpt);
+  report["variants"] = variants;
+
+  QFile file(parser.value(outputOpt));
+  if (!file.open(QIODevice::WriteOnly)) {
+    QTextStream(stderr) << "couldn't write " << file.fileName() << Qt::endl;
+    return 1;
+  }
+  file.write(QJsonDocument(report).toJson());
+  out << "results written to " << file.fileName() << Qt::endl;
+
+  return 0;
+}
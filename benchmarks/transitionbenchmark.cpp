@@ -0,0 +1,131 @@
+/**
+ * @file transitionbenchmark.cpp
+ * @brief Verse transition latency benchmark.
+ *
+ * Plays a surah of short verses through VersePlayer and PlaybackController
+ * the way the application does, with the output muted, and reports the
+ * transition latency & source load distributions collected by the
+ * TransitionMonitor. The verses of the surah must be downloaded.
+ */
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+#include <player/impl/setplaybackstrategy.h>
+#include <player/playbackcontroller.h>
+#include <player/transitionmonitor.h>
+#include <service/servicefactory.h>
+#include <types/reciter.h>
+#include <utils/appinfo.h>
+#include <utils/catalogcache.h>
+#include <utils/recitationindex.h>
+
+/**
+ * @brief benchmark entry point
+ */
+int
+main(int argc, char* argv[])
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QApplication app(argc, argv);
+  AppInfo::apply();
+
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  QCommandLineOption reciterOpt(
+    "reciter", "Reciter directory name.", "reciter", "Al-Husary");
+  QCommandLineOption surahOpt("surah", "Surah to play.", "surah", "97");
+  QCommandLineOption repeatOpt(
+    "repeat", "Times the surah is played.", "count", "5");
+  QCommandLineOption gaplessOpt("gapless", "Preload the next verse.");
+  QCommandLineOption pcmOpt("pcm", "Play through the PCM audio engine.");
+  QCommandLineOption outputOpt(
+    "output", "JSON output file.", "path", "transition-benchmark.json");
+  parser.addOptions(
+    { reciterOpt, surahOpt, repeatOpt, gaplessOpt, pcmOpt, outputOpt });
+  parser.process(app);
+
+  QTextStream out(stdout);
+  QTextStream err(stderr);
+  int surah = std::clamp(parser.value(surahOpt).toInt(), 1, 114);
+  int repeat = std::max(1, parser.value(repeatOpt).toInt());
+
+  CatalogCache::getInstance().load();
+  Reciter::populateReciters();
+  int reciter = -1;
+  for (int i = 0; i < Reciter::reciters.size(); i++) {
+    if (Reciter::reciters.at(i).baseDirName() == parser.value(reciterOpt))
+      reciter = i;
+  }
+  if (reciter < 0) {
+    err << "unknown reciter: " << parser.value(reciterOpt) << Qt::endl;
+    return 1;
+  }
+  if (!RecitationIndex::getInstance().isSurahComplete(reciter, surah)) {
+    err << "surah " << surah << " is not downloaded for "
+        << parser.value(reciterOpt) << Qt::endl;
+    return 1;
+  }
+
+  // a muted output stands in for a null audio sink, the media backend still
+  // decodes & paces the audio as it would for a real device
+  VersePlayer* player = new VersePlayer(&app, reciter);
+  player->setGapless(parser.isSet(gaplessOpt));
+  player->setPcmEngine(parser.isSet(pcmOpt), 128);
+  player->setPlayerVolume(0);
+
+  const QuranService* quranService = ServiceFactory::quranService();
+  int count = Verse::surahVerseCount(surah);
+  Verse start(quranService->versePage(surah, 1), surah, 1);
+  Verse end(quranService->versePage(surah, count), surah, count);
+
+  PlaybackController controller(&app, player);
+  controller.setStrategy(
+    std::make_shared<SetPlaybackStrategy>(start, end, repeat));
+  QObject::connect(&controller,
+                   &PlaybackController::playbackFinished,
+                   &app,
+                   &QApplication::quit);
+
+  // generous limit for the whole run in case the playback stalls
+  QTimer::singleShot(repeat * count * 60000, &app, [&err]() {
+    err << "playback timed out" << Qt::endl;
+    QApplication::exit(1);
+  });
+
+  TransitionMonitor::getInstance().reset();
+  controller.start();
+  int code = app.exec();
+
+  TransitionMonitor& monitor = TransitionMonitor::getInstance();
+  out << repeat << "x surah " << surah << " (" << count << " verses) of "
+      << parser.value(reciterOpt) << Qt::endl
+      << monitor.report() << Qt::endl;
+
+  QJsonObject report;
+  report["version"] = QApplication::applicationVersion();
+  report["reciter"] = parser.value(reciterOpt);
+  report["surah"] = surah;
+  report["repeat"] = repeat;
+  report["gapless"] = parser.isSet(gaplessOpt);
+  report["pcm"] = parser.isSet(pcmOpt);
+  report["completed"] = code == 0;
+  report["monitor"] = monitor.toJson();
+
+  QFile file(parser.value(outputOpt));
+  if (!file.open(QIODevice::WriteOnly)) {
+    err << "couldn't write " << file.fileName() << Qt::endl;
+    return 1;
+  }
+  file.write(QJsonDocument(report).toJson());
+  out << "results written to " << file.fileName() << Qt::endl;
+
+  return code;
+}
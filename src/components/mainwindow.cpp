@@ -11,6 +11,8 @@
 #include <player/impl/setplaybackstrategy.h>
 #include <player/playbackcontroller.h>
 #include <service/servicefactory.h>
+#include <utils/singleinstance.h>
+#include <utils/startupscheduler.h>
 #include <utils/stylemanager.h>
 using namespace fa;
 using std::make_pair;
@@ -48,6 +50,7 @@ MainWindow::MainWindow(QWidget* parent)
   this->show();
 
   m_popup->setDockArea(dockWidgetArea(ui->sideDock));
+  deferComponents();
 }
 
 void
@@ -90,25 +93,18 @@ MainWindow::loadComponents()
 {
   QPointer<VersePlayer> player =
     new VersePlayer(this, m_config.settings().value("Reciter", 0).toInt());
+  player->setGapless(m_config.settings().value("GaplessPlayback").toBool());
+  player->setStreaming(
+    m_config.settings().value("StreamMissingVerses").toBool());
+  player->setPcmEngine(m_config.settings().value("PcmAudioEngine").toBool(),
+                       m_config.settings().value("PcmCacheSize").toInt());
   m_playbackController = new PlaybackController(this, player);
   m_reader = new QuranReader(this, m_playbackController);
   m_repeater = new RepeaterPopup(this, m_playbackController);
   m_playerControls =
     new PlayerControls(this, m_playbackController, m_reader, m_repeater);
-  m_settingsDlg = new SettingsDialog(this, player);
   m_popup = new NotificationPopup(this);
-  m_betaqaViewer = new BetaqaViewer(this);
-  m_verseDlg = new VerseDialog(this);
-  m_cpyDlg = new CopyDialog(this);
-  m_systemTray = new SystemTray(this);
-  m_contentDlg = new ContentDialog(this);
   m_jobMgr = new JobManager(this);
-  m_versionChecker = new VersionChecker(this);
-  m_selectorDlg = new FileSelector(this);
-  m_importExportDlg =
-    new ImportExportDialog(this,
-                           QSharedPointer<JsonDataImporter>::create(),
-                           QSharedPointer<JsonDataExporter>::create());
 
   QHBoxLayout* controls = new QHBoxLayout();
   QFrame* controlsFrame = new QFrame(this);
@@ -138,15 +134,112 @@ MainWindow::loadComponents()
   ui->cmbPage->setCurrentIndex(m_currVerse.page() - 1);
 }
 
+void
+MainWindow::deferComponents()
+{
+  // dialogs are created on first use, the rest is created once the first
+  // page is painted
+  StartupScheduler& scheduler = StartupScheduler::getInstance();
+  scheduler.defer("MainWindow::setupTray", [this]() { setupTray(); });
+  if (m_config.settings().value("VOTD").toBool())
+    scheduler.defer("VerseDialog", [this]() { verseDialog(); });
+}
+
+void
+MainWindow::setupTray()
+{
+  m_systemTray = new SystemTray(this);
+  connectTray();
+  updateTrayTooltip(m_playbackController->player()->playbackState());
+}
+
+SettingsDialog*
+MainWindow::settingsDialog()
+{
+  if (m_settingsDlg == nullptr) {
+    m_settingsDlg = new SettingsDialog(this, m_playbackController->player());
+    connectSettings();
+  }
+
+  return m_settingsDlg;
+}
+
+ContentDialog*
+MainWindow::contentDialog()
+{
+  if (m_contentDlg == nullptr) {
+    m_contentDlg = new ContentDialog(this);
+    connect(m_contentDlg,
+            &ContentDialog::missingTafsir,
+            this,
+            &MainWindow::missingTafsir);
+    connect(m_contentDlg,
+            &ContentDialog::missingTranslation,
+            this,
+            &MainWindow::missingTranslation);
+  }
+
+  return m_contentDlg;
+}
+
+CopyDialog*
+MainWindow::copyDialog()
+{
+  if (m_cpyDlg == nullptr) {
+    m_cpyDlg = new CopyDialog(this);
+    m_popup->registerSender(m_cpyDlg->notifier());
+  }
+
+  return m_cpyDlg;
+}
+
+BetaqaViewer*
+MainWindow::betaqaViewer()
+{
+  if (m_betaqaViewer == nullptr) {
+    m_betaqaViewer = new BetaqaViewer(this);
+    m_betaqaViewer->center();
+  }
+
+  return m_betaqaViewer;
+}
+
+VerseDialog*
+MainWindow::verseDialog()
+{
+  if (m_verseDlg == nullptr)
+    m_verseDlg = new VerseDialog(this);
+
+  return m_verseDlg;
+}
+
+PlaybackStatsDialog*
+MainWindow::playbackStatsDialog()
+{
+  if (m_playbackStatsDlg == nullptr)
+    m_playbackStatsDlg = new PlaybackStatsDialog(this);
+
+  return m_playbackStatsDlg;
+}
+
+VersionChecker*
+MainWindow::versionChecker()
+{
+  if (m_versionChecker == nullptr) {
+    m_versionChecker = new VersionChecker(this);
+    m_popup->registerSender(m_versionChecker->notifier());
+  }
+
+  return m_versionChecker;
+}
+
 void
 MainWindow::setupConnections()
 {
   connectMenubar();
-  connectTray();
   connectReader();
   connectPlayer();
   connectControls();
-  connectSettings();
   connectNotifiers();
   m_navigator.addObserver(this);
 }
@@ -189,6 +282,12 @@ MainWindow::setupShortcuts()
        }) {
     connect(&m_shortcutHandler, connection.first, this, connection.second);
   }
+
+  // debug only, not listed with the configurable shortcuts
+  QShortcut* stats = new QShortcut(QKeySequence("Ctrl+Shift+F12"), this);
+  connect(stats, &QShortcut::activated, this, [this]() {
+    playbackStatsDialog()->show();
+  });
 }
 
 void
@@ -199,7 +298,7 @@ MainWindow::connectPlayer()
           this,
           &MainWindow::missingRecitationFileWarn);
   connect(m_playbackController->player(),
-          &QMediaPlayer::playbackStateChanged,
+          &VersePlayer::playbackStateChanged,
           this,
           &MainWindow::updateTrayTooltip);
 }
@@ -216,8 +315,8 @@ MainWindow::connectTray()
   connect(m_systemTray, &SystemTray::hideWindow, this, &MainWindow::hide);
   connect(m_systemTray,
           &SystemTray::checkForUpdates,
-          m_versionChecker,
-          &VersionChecker::checkUpdates);
+          this,
+          &MainWindow::actionUpdatesTriggered);
   connect(m_systemTray,
           &SystemTray::openAbout,
           this,
@@ -231,34 +330,25 @@ MainWindow::connectTray()
 void
 MainWindow::connectReader()
 {
-  connect(m_reader,
-          &QuranReader::copyVerseText,
-          m_cpyDlg,
-          &CopyDialog::copyVerseText);
-  connect(m_reader,
-          &QuranReader::showVerseTafsir,
-          m_contentDlg,
-          &ContentDialog::showVerseTafsir);
-  connect(m_reader,
-          &QuranReader::showVerseTranslation,
-          m_contentDlg,
-          &ContentDialog::showVerseTranslation);
-  connect(m_reader,
-          &QuranReader::showVerseThoughts,
-          m_contentDlg,
-          &ContentDialog::showVerseThoughts);
-  connect(m_reader,
-          &QuranReader::showBetaqa,
-          m_betaqaViewer,
-          &BetaqaViewer::showSurah);
-  connect(m_contentDlg,
-          &ContentDialog::missingTafsir,
-          this,
-          &MainWindow::missingTafsir);
-  connect(m_contentDlg,
-          &ContentDialog::missingTranslation,
-          this,
-          &MainWindow::missingTranslation);
+  // the dialogs are created when the reader first requests them
+  connect(m_reader, &QuranReader::copyVerseText, this, [this](const Verse& v) {
+    copyDialog()->copyVerseText(v);
+  });
+  connect(
+    m_reader, &QuranReader::showVerseTafsir, this, [this](const Verse& v) {
+      contentDialog()->showVerseTafsir(v);
+    });
+  connect(
+    m_reader, &QuranReader::showVerseTranslation, this, [this](const Verse& v) {
+      contentDialog()->showVerseTranslation(v);
+    });
+  connect(
+    m_reader, &QuranReader::showVerseThoughts, this, [this](const Verse& v) {
+      contentDialog()->showVerseThoughts(v);
+    });
+  connect(m_reader, &QuranReader::showBetaqa, this, [this](int surah) {
+    betaqaViewer()->showSurah(surah);
+  });
 }
 
 void
@@ -374,8 +464,6 @@ void
 MainWindow::connectNotifiers()
 {
   m_popup->registerSender(m_jobMgr->notifier());
-  m_popup->registerSender(m_versionChecker->notifier());
-  m_popup->registerSender(m_cpyDlg->notifier());
   m_popup->registerSender(m_bookmarkService->notifier());
   connect(ui->sideDock,
           &QDockWidget::dockLocationChanged,
@@ -466,6 +554,12 @@ MainWindow::activeVerseChanged()
     setCmbVerseIdx(curr.number() - 1);
 }
 
+bool
+MainWindow::suspendedInBackground() const
+{
+  return true;
+}
+
 void
 MainWindow::setCmbPageIdx(int idx)
 {
@@ -568,6 +662,9 @@ MainWindow::cmbJuzChanged(int newJuzIdx)
 void
 MainWindow::updateTrayTooltip(QMediaPlayer::PlaybackState state)
 {
+  if (m_systemTray == nullptr)
+    return;
+
   if (state == QMediaPlayer::PlayingState) {
     m_systemTray->setTooltip(
       tr("Now playing: ") + m_playbackController->player()->reciterName() +
@@ -587,7 +684,7 @@ MainWindow::bookmarkCurrent()
 void
 MainWindow::actionUpdatesTriggered()
 {
-  m_versionChecker->checkUpdates();
+  versionChecker()->checkUpdates();
 }
 
 void
@@ -657,7 +754,7 @@ MainWindow::missingRecitationFileWarn(int reciterIdx, int surah)
 void
 MainWindow::actionPrefTriggered()
 {
-  m_settingsDlg->showWindow();
+  settingsDialog()->showWindow();
 }
 
 void
@@ -691,19 +788,19 @@ MainWindow::actionKhatmahTriggered()
 void
 MainWindow::actionAdvancedCopyTriggered()
 {
-  m_cpyDlg->show();
+  copyDialog()->show();
 }
 
 void
 MainWindow::actionTafsirTriggered()
 {
-  m_contentDlg->showVerseTafsir(m_currVerse);
+  contentDialog()->showVerseTafsir(m_currVerse);
 }
 
 void
 MainWindow::actionVotdTriggered()
 {
-  m_verseDlg->showVOTD(false);
+  verseDialog()->showVOTD(false);
 }
 
 void
@@ -731,11 +828,8 @@ MainWindow::actionSearchTriggered()
 void
 MainWindow::actionPlayerControlsToggled(bool checked)
 {
+  // the page browsers adapt to the reader size change on their own
   m_playerControls->setVisible(checked);
-  if (m_config.settings().value("Reader/AdaptiveFont").toBool()) {
-    m_reader->redrawQuranPage();
-    m_reader->highlightCurrentVerse();
-  }
 }
 
 void
@@ -791,6 +885,28 @@ MainWindow::toggleMenubar()
   m_repeater->adjustPosition();
 }
 
+void
+MainWindow::showEvent(QShowEvent* event)
+{
+  QMainWindow::showEvent(event);
+  m_navigator.setBackground(isMinimized());
+}
+
+void
+MainWindow::hideEvent(QHideEvent* event)
+{
+  QMainWindow::hideEvent(event);
+  m_navigator.setBackground(true);
+}
+
+void
+MainWindow::changeEvent(QEvent* event)
+{
+  QMainWindow::changeEvent(event);
+  if (event->type() == QEvent::WindowStateChange)
+    m_navigator.setBackground(isMinimized() || !isVisible());
+}
+
 void
 MainWindow::toggleNavDock()
 {
@@ -798,9 +914,23 @@ MainWindow::toggleNavDock()
   m_repeater->adjustPosition();
 }
 
+void
+MainWindow::setupImportExport()
+{
+  if (m_selectorDlg != nullptr)
+    return;
+
+  m_selectorDlg = new FileSelector(this);
+  m_importExportDlg =
+    new ImportExportDialog(this,
+                           QSharedPointer<JsonDataImporter>::create(),
+                           QSharedPointer<JsonDataExporter>::create());
+}
+
 void
 MainWindow::importUserData()
 {
+  setupImportExport();
   QString path = m_selectorDlg->selectJson(FileSelector::Read);
   if (!path.isEmpty())
     m_importExportDlg->selectImports(path);
@@ -809,6 +939,7 @@ MainWindow::importUserData()
 void
 MainWindow::exportUserData()
 {
+  setupImportExport();
   QString path = m_selectorDlg->selectJson(FileSelector::Write);
   if (!path.isEmpty())
     m_importExportDlg->selectExports(path);
@@ -820,7 +951,8 @@ MainWindow::resizeEvent(QResizeEvent* event)
   QMainWindow::resizeEvent(event);
   m_popup->adjustLocation();
   m_popup->move(m_popup->notificationPos());
-  m_betaqaViewer->center();
+  if (m_betaqaViewer != nullptr)
+    m_betaqaViewer->center();
   m_repeater->adjustPosition();
 }
 
@@ -834,10 +966,47 @@ MainWindow::saveReaderState()
   m_khatmahService->saveActiveKhatmah(m_currVerse);
 }
 
+void
+MainWindow::handleRequest(const QJsonObject& request)
+{
+  // the window might be minimized or hidden in the tray
+  setWindowState((windowState() & ~Qt::WindowMinimized) | Qt::WindowActive);
+  show();
+  raise();
+  activateWindow();
+
+  if (request.contains("verse")) {
+    QStringList parts = request["verse"].toString().split(':');
+    int surah = parts.first().toInt();
+    int number = parts.size() > 1 ? parts.last().toInt() : 1;
+    if (number >= 1 && number <= Verse::surahVerseCount(surah)) {
+      int page = m_quranService->getVersePage(surah, number);
+      m_navigator.navigateToVerse(Verse(page, surah, number));
+    } else
+      qWarning() << "Invalid verse in request:" << request["verse"];
+  } else if (request.contains("page")) {
+    int page = request["page"].toInt();
+    if (page >= 1 && page <= 604)
+      m_navigator.navigateToPage(page);
+    else
+      qWarning() << "Invalid page in request:" << request["page"];
+  }
+
+  if (request["play"].toBool() && !m_playbackController->player()->isPlaying())
+    m_playbackController->start();
+
+  if (request.contains("find")) {
+    actionSearchTriggered();
+    m_searchDlg->searchFor(request["find"].toString());
+  }
+}
+
 void
 MainWindow::restartApp()
 {
   saveReaderState();
+  // the new instance would hand off to this one otherwise
+  SingleInstance::getInstance().close();
   QProcess::startDetached(qApp->arguments()[0], qApp->arguments());
   emit QApplication::exit();
 }
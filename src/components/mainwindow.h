@@ -8,6 +8,7 @@
 
 #include <QBoxLayout>
 #include <QIntValidator>
+#include <QJsonObject>
 #include <QMainWindow>
 #include <QScrollArea>
 #include <QScrollBar>
@@ -24,6 +25,7 @@
 #include <dialogs/fileselector.h>
 #include <dialogs/importexportdialog.h>
 #include <dialogs/khatmahdialog.h>
+#include <dialogs/playbackstatsdialog.h>
 #include <dialogs/searchdialog.h>
 #include <dialogs/settingsdialog.h>
 #include <dialogs/versedialog.h>
@@ -64,6 +66,12 @@ public:
   ~MainWindow();
 
   void activeVerseChanged();
+  /**
+   * @brief the combobox & surah list updates are deferred while the window is
+   * hidden or minimized
+   * @return true
+   */
+  bool suspendedInBackground() const;
 
 public slots:
   /**
@@ -75,6 +83,12 @@ public slots:
    * @brief restart the application
    */
   void restartApp();
+  /**
+   * @brief bring the window forward and handle a command line request, see
+   * SingleInstance for the request keys
+   * @param request - QJsonObject of the request
+   */
+  void handleRequest(const QJsonObject& request);
 
 protected:
   /**
@@ -83,6 +97,24 @@ protected:
    * @param event
    */
   void resizeEvent(QResizeEvent* event);
+  /**
+   * @brief re-implementation of QWidget::showEvent(QShowEvent*) to apply the
+   * verse changes deferred while the window was hidden
+   * @param event
+   */
+  void showEvent(QShowEvent* event);
+  /**
+   * @brief re-implementation of QWidget::hideEvent(QHideEvent*) to defer the
+   * UI updates of verse changes while the window is hidden, e.g. in the tray
+   * @param event
+   */
+  void hideEvent(QHideEvent* event);
+  /**
+   * @brief re-implementation of QWidget::changeEvent(QEvent*) to defer the UI
+   * updates of verse changes while the window is minimized
+   * @param event
+   */
+  void changeEvent(QEvent* event);
 
 private slots:
   /**
@@ -289,9 +321,58 @@ private:
    */
   const QList<Tafsir>& m_tafasir;
   /**
-   * @brief initalizes different parts used by the app
+   * @brief initalizes the parts of the app needed to show the current page
    */
   void loadComponents();
+  /**
+   * @brief schedule the creation of the components that are not needed for
+   * the first page once the window is painted
+   */
+  void deferComponents();
+  /**
+   * @brief create the SystemTray icon and connect its signals
+   */
+  void setupTray();
+  /**
+   * @brief create the file selector & import/export dialogs if not set
+   */
+  void setupImportExport();
+  /**
+   * @brief get the SettingsDialog, create instance and connect its signals if
+   * not set
+   * @return pointer to the SettingsDialog instance
+   */
+  SettingsDialog* settingsDialog();
+  /**
+   * @brief get the ContentDialog, create instance if not set
+   * @return pointer to the ContentDialog instance
+   */
+  ContentDialog* contentDialog();
+  /**
+   * @brief get the CopyDialog, create instance if not set
+   * @return pointer to the CopyDialog instance
+   */
+  CopyDialog* copyDialog();
+  /**
+   * @brief get the surah card (betaqa) widget, create instance if not set
+   * @return pointer to the BetaqaViewer instance
+   */
+  BetaqaViewer* betaqaViewer();
+  /**
+   * @brief get the votd dialog, create instance if not set
+   * @return pointer to the VerseDialog instance
+   */
+  VerseDialog* verseDialog();
+  /**
+   * @brief get the playback statistics dialog, create instance if not set
+   * @return pointer to the PlaybackStatsDialog instance
+   */
+  PlaybackStatsDialog* playbackStatsDialog();
+  /**
+   * @brief get the VersionChecker, create instance if not set
+   * @return pointer to the VersionChecker instance
+   */
+  VersionChecker* versionChecker();
   /**
    * @brief load icons for different UI elements
    */
@@ -469,6 +550,10 @@ private:
    * @brief pointer to the votd dialog
    */
   QPointer<VerseDialog> m_verseDlg;
+  /**
+   * @brief pointer to the playback statistics dialog
+   */
+  QPointer<PlaybackStatsDialog> m_playbackStatsDlg;
   /**
    * @brief pointer to the FileSelector dialog used for selecting files for
    * import/export
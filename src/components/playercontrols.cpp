@@ -61,18 +61,18 @@ PlayerControls::setupConnections()
           &PlayerControls::decrementVolume);
 
   connect(m_playbackController->player(),
-          &QMediaPlayer::positionChanged,
+          &VersePlayer::positionChanged,
           this,
           &PlayerControls::mediaPosChanged);
   connect(m_playbackController->player(),
-          &QMediaPlayer::playbackStateChanged,
+          &VersePlayer::playbackStateChanged,
           this,
           &PlayerControls::mediaStateChanged);
 
   connect(ui->sldrAudioPlayer,
           &QSlider::sliderMoved,
           m_playbackController->player(),
-          &QMediaPlayer::setPosition);
+          &VersePlayer::setPosition);
   connect(ui->sldrVolume,
           &QSlider::valueChanged,
           this,
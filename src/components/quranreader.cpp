@@ -1,6 +1,7 @@
 #include "quranreader.h"
 #include "ui_quranreader.h"
 #include <QtAwesome.h>
+#include <QtConcurrent>
 #include <service/servicefactory.h>
 #include <utils/fontmanager.h>
 #include <utils/shortcuthandler.h>
@@ -53,9 +54,7 @@ QuranReader::loadReader()
 
     QWidget* scrollWidget = new QWidget();
     scrollWidget->setObjectName("scrollWidget");
-    QVBoxLayout* vbl = new QVBoxLayout();
-    vbl->setDirection(QBoxLayout::BottomToTop);
-    scrollWidget->setLayout(vbl);
+    scrollWidget->setLayout(new QVBoxLayout());
 
     m_scrlVerseByVerse = new QScrollArea;
     m_scrlVerseByVerse->setWidget(scrollWidget);
@@ -72,6 +71,12 @@ QuranReader::loadReader()
     this->setMinimumWidth(900);
   }
 
+  else if (m_config.readerMode() == ReaderMode::ContinuousScroll) {
+    m_scrollView = new QuranScrollView(ui->frmPageContent, m_currVerse.page());
+    ui->frmSidePanel->setVisible(false);
+    ui->frmPageContent->layout()->addWidget(m_scrollView);
+  }
+
   else {
     // even Quran pages are always on the left side
     if (m_currVerse.page() % 2 == 0) {
@@ -98,7 +103,8 @@ QuranReader::loadReader()
     lyt->setStretch(3, 1);
   }
 
-  ui->frmPageContent->layout()->addWidget(m_quranBrowsers[0]);
+  if (m_quranBrowsers[0])
+    ui->frmPageContent->layout()->addWidget(m_quranBrowsers[0]);
 }
 
 void
@@ -108,12 +114,37 @@ QuranReader::setupConnections()
     ui->btnNext, &QPushButton::clicked, this, &QuranReader::btnNextClicked);
   connect(
     ui->btnPrev, &QPushButton::clicked, this, &QuranReader::btnPrevClicked);
-  for (int i = 0; i <= 1; i++)
-    if (m_quranBrowsers[i])
-      connect(m_quranBrowsers[i],
-              &QTextBrowser::anchorClicked,
-              this,
-              &QuranReader::verseAnchorClicked);
+  for (QuranPageBrowser* browser : pageBrowsers()) {
+    connect(browser,
+            &QTextBrowser::anchorClicked,
+            this,
+            &QuranReader::verseAnchorClicked);
+    connect(browser,
+            &QuranPageBrowser::verseClicked,
+            this,
+            &QuranReader::pageVerseClicked);
+
+    // the frame holding a page fits its longest line
+    if (!m_scrollView) {
+      QWidget* frame = browser->parentWidget();
+      frame->setMinimumWidth(browser->minimumPageWidth());
+      connect(browser,
+              &QuranPageBrowser::minimumPageWidthChanged,
+              frame,
+              &QWidget::setMinimumWidth);
+    }
+  }
+
+  if (m_scrollView) {
+    connect(m_scrollView,
+            &QuranScrollView::currentPageChanged,
+            this,
+            &QuranReader::scrolledToPage);
+    connect(m_scrollView,
+            &QuranScrollView::pagesRecycled,
+            this,
+            &QuranReader::scrollPagesRecycled);
+  }
 
   const ShortcutHandler& handler = ShortcutHandler::getInstance();
   connect(
@@ -125,17 +156,15 @@ QuranReader::setupConnections()
           this,
           &QuranReader::toggleReaderView);
 
-  for (int i = 0; i <= 1; i++) {
-    if (m_quranBrowsers[i]) {
-      connect(&handler,
-              &ShortcutHandler::zoomIn,
-              m_quranBrowsers[i],
-              &QuranPageBrowser::actionZoomIn);
-      connect(&handler,
-              &ShortcutHandler::zoomOut,
-              m_quranBrowsers[i],
-              &QuranPageBrowser::actionZoomOut);
-    }
+  for (QuranPageBrowser* browser : pageBrowsers()) {
+    connect(&handler,
+            &ShortcutHandler::zoomIn,
+            browser,
+            &QuranPageBrowser::actionZoomIn);
+    connect(&handler,
+            &ShortcutHandler::zoomOut,
+            browser,
+            &QuranPageBrowser::actionZoomOut);
   }
 
   m_navigator.addObserver(this);
@@ -165,6 +194,8 @@ QuranReader::updateVerseType()
 {
   Configuration::VerseType type = qvariant_cast<Configuration::VerseType>(
     m_config.settings().value("Reader/VerseType"));
+  if (type == Configuration::Qcf)
+    FontManager::getInstance().pinPageFont(this, m_currVerse.page());
   m_versesFont.setFamily(
     FontManager::getInstance().verseFontname(type, m_currVerse.page()));
   m_versesFont.setPointSize(
@@ -175,76 +206,110 @@ QuranReader::updateVerseType()
 void
 QuranReader::updateHighlight()
 {
-  for (int i = 0; i <= 1; i++) {
-    if (m_quranBrowsers[i]) {
-      m_quranBrowsers[i]->updateHighlightLayer();
-    }
-  }
+  for (QuranPageBrowser* browser : pageBrowsers())
+    browser->updateHighlightLayer();
 }
 
 void
 QuranReader::updatePageFontSize()
 {
+  for (QuranPageBrowser* browser : pageBrowsers())
+    browser->updateFontSize();
+}
+
+QList<QuranPageBrowser*>
+QuranReader::pageBrowsers() const
+{
+  if (m_scrollView)
+    return m_scrollView->browsers();
+
+  QList<QuranPageBrowser*> browsers;
   for (int i = 0; i <= 1; i++)
     if (m_quranBrowsers[i])
-      m_quranBrowsers[i]->updateFontSize();
+      browsers.append(m_quranBrowsers[i]);
+
+  return browsers;
 }
 
 void
 QuranReader::redrawQuranPage(bool manualSz)
 {
-  if (m_activeQuranBrowser == m_quranBrowsers[0]) {
-    m_quranBrowsers[0]->constructPage(m_currVerse.page(), manualSz);
-    if (m_config.readerMode() == Configuration::DoublePage &&
-        m_quranBrowsers[1])
-      m_quranBrowsers[1]->constructPage(m_currVerse.page() + 1, manualSz);
+  if (m_scrollView) {
+    m_scrollView->redrawPages(manualSz);
+    m_activeQuranBrowser = m_scrollView->pageBrowser(m_currVerse.page());
+  } else if (m_quranBrowsers[1]) {
+    int rightPage = m_activeQuranBrowser == m_quranBrowsers[0]
+                      ? m_currVerse.page()
+                      : m_currVerse.page() - 1;
+    constructDoublePage(rightPage, manualSz);
+    return;
   } else {
-    m_quranBrowsers[0]->constructPage(m_currVerse.page() - 1, manualSz);
-    m_quranBrowsers[1]->constructPage(m_currVerse.page(), manualSz);
+    m_quranBrowsers[0]->constructPage(m_currVerse.page(), manualSz);
   }
 
   updatePageVerseInfoList();
 }
 
+void
+QuranReader::constructDoublePage(int rightPage, bool manualSz)
+{
+  QuranPageBrowser* right = m_quranBrowsers[0];
+  QuranPageBrowser* left = m_quranBrowsers[1];
+
+  // database access & font registration stay in the GUI thread
+  right->preparePage(rightPage, manualSz);
+  left->preparePage(rightPage + 1, manualSz);
+
+  QThread* guiThread = thread();
+  QFuture<QTextDocument*> leftDoc = QtConcurrent::run([left, guiThread]() {
+    QTextDocument* doc = left->buildPageDocument();
+    doc->moveToThread(guiThread);
+    return doc;
+  });
+  QTextDocument* rightDoc = right->buildPageDocument();
+  updatePageVerseInfoList();
+
+  right->setPageDocument(rightDoc);
+  left->setPageDocument(leftDoc.result());
+}
+
 void
 QuranReader::addSideContent()
 {
   if (m_config.readerMode() != ReaderMode::SinglePage)
     return;
 
-  if (!m_verseFrameList.isEmpty()) {
-    qDeleteAll(m_verseFrameList);
-    m_verseFrameList.clear();
+  if (m_highlightedFrm) {
+    m_highlightedFrm->setSelected(false);
     m_highlightedFrm = nullptr;
   }
 
-  ClickableLabel* verselb;
-  QLabel* contentLb;
-  VerseFrame* verseContFrame;
+  // frames are only created when a page has more verses than any page shown
+  // before, otherwise the existing ones are refilled
+  while (m_verseFrameList.size() < m_activeVList->size())
+    m_verseFrameList.append(createVerseFrame(m_verseFrameList.size()));
+
   QString prevLbContent, currLbContent, glyphs;
-  if (m_config.verseType() == Configuration::Qcf)
+  // the side panel labels use the font of the displayed page
+  if (m_config.verseType() == Configuration::Qcf) {
+    FontManager::getInstance().pinPageFont(this, m_currVerse.page());
     m_versesFont.setFamily(
       FontManager::getInstance().pageFontname(m_currVerse.page()));
+  }
 
+  m_verseFrameRows.clear();
   m_translationService->loadTranslation();
   for (int i = m_activeVList->size() - 1; i >= 0; i--) {
     const Verse* verse = &(m_activeVList->at(i));
+    const SideVerseFrame& item = m_verseFrameList.at(i);
 
-    verseContFrame = new VerseFrame(m_scrlVerseByVerse->widget());
-    verselb = new ClickableLabel(verseContFrame);
-    contentLb = new QLabel(verseContFrame);
     glyphs = m_config.verseType() == Configuration::Qcf
-               ? m_glyphService->getVerseGlyphs(verse->surah(), verse->number())
+               ? m_glyphService->getVerseGlyphs(
+                   verse->surah(), verse->number(), verse->page())
                : m_quranService->verseText(verse->surah(), verse->number());
 
-    verseContFrame->setObjectName(QString::number(verse->page()) + "_" +
-                                  QString::number(verse->surah()) + "_" +
-                                  QString::number(verse->number()));
-
-    verselb->setFont(m_versesFont);
-    verselb->setText(glyphs);
-    verselb->setAlignment(Qt::AlignCenter);
-    verselb->setWordWrap(true);
+    item.verseLb->setFont(m_versesFont);
+    item.verseLb->setText(glyphs);
 
     currLbContent =
       m_translationService->getTranslation(verse->surah(), verse->number());
@@ -255,27 +320,46 @@ QuranReader::addSideContent()
       prevLbContent = currLbContent;
     }
 
-    contentLb->setText(currLbContent);
-    contentLb->setTextInteractionFlags(Qt::TextSelectableByMouse);
-    contentLb->setAlignment(Qt::AlignCenter);
-    contentLb->setWordWrap(true);
-    contentLb->setFont(m_sideFont);
+    item.contentLb->setFont(m_sideFont);
+    item.contentLb->setText(currLbContent);
+    item.frame->show();
+    m_verseFrameRows.insert(Verse::id(verse->surah(), verse->number()), i);
+  }
 
-    verseContFrame->layout()->addWidget(verselb);
-    verseContFrame->layout()->addWidget(contentLb);
-    m_scrlVerseByVerse->widget()->layout()->addWidget(verseContFrame);
-    m_verseFrameList.insert(0, verseContFrame);
+  for (int i = m_activeVList->size(); i < m_verseFrameList.size(); i++)
+    m_verseFrameList.at(i).frame->hide();
+}
 
-    // connect clicked signal for each label
-    connect(
-      verselb, &ClickableLabel::clicked, this, &QuranReader::verseClicked);
-  }
+QuranReader::SideVerseFrame
+QuranReader::createVerseFrame(int row)
+{
+  SideVerseFrame item;
+  item.frame = new VerseFrame(m_scrlVerseByVerse->widget());
+  item.verseLb = new ClickableLabel(item.frame);
+  item.contentLb = new QLabel(item.frame);
+
+  item.verseLb->setProperty("row", row);
+  item.verseLb->setAlignment(Qt::AlignCenter);
+  item.verseLb->setWordWrap(true);
+
+  item.contentLb->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  item.contentLb->setAlignment(Qt::AlignCenter);
+  item.contentLb->setWordWrap(true);
+
+  item.frame->layout()->addWidget(item.verseLb);
+  item.frame->layout()->addWidget(item.contentLb);
+  m_scrlVerseByVerse->widget()->layout()->addWidget(item.frame);
+
+  connect(
+    item.verseLb, &ClickableLabel::clicked, this, &QuranReader::verseClicked);
+
+  return item;
 }
 
 void
 QuranReader::highlightCurrentVerse()
 {
-  if (m_currVerse.number() == 0)
+  if (m_currVerse.number() == 0 || !m_activeQuranBrowser)
     return;
 
   // idx may be -1 if verse number is 0 (basmallah)
@@ -295,11 +379,14 @@ QuranReader::setHighlightedFrame()
   if (m_highlightedFrm != nullptr)
     m_highlightedFrm->setSelected(false);
 
-  VerseFrame* verseFrame = m_scrlVerseByVerse->widget()->findChild<VerseFrame*>(
-    QString::number(m_currVerse.page()) + "_" +
-    QString::number(m_currVerse.surah()) + "_" +
-    QString::number(m_currVerse.number()));
+  int row = m_verseFrameRows.value(
+    Verse::id(m_currVerse.surah(), m_currVerse.number()), -1);
+  if (row < 0) {
+    m_highlightedFrm = nullptr;
+    return;
+  }
 
+  VerseFrame* verseFrame = m_verseFrameList.at(row).frame;
   verseFrame->setSelected(true);
 
   m_scrlVerseByVerse->ensureWidgetVisible(verseFrame);
@@ -309,7 +396,10 @@ QuranReader::setHighlightedFrame()
 void
 QuranReader::updatePageVerseInfoList()
 {
-  if (m_activeQuranBrowser == m_quranBrowsers[0]) {
+  if (m_scrollView) {
+    m_vLists[0] = m_quranService->verseInfoList(m_currVerse.page());
+    m_activeVList = &m_vLists[0];
+  } else if (m_activeQuranBrowser == m_quranBrowsers[0]) {
     m_vLists[0] = m_quranService->verseInfoList(m_currVerse.page());
     if (m_config.readerMode() == Configuration::DoublePage)
       m_vLists[1] = m_quranService->verseInfoList(m_currVerse.page() + 1);
@@ -370,13 +460,6 @@ QuranReader::switchActivePage()
   }
 }
 
-void
-QuranReader::selectVerse(int browserIdx, int IdxInPage)
-{
-  const Verse& v = m_vLists[browserIdx].at(IdxInPage);
-  m_navigator.navigateToVerse(v);
-}
-
 void
 QuranReader::verseAnchorClicked(const QUrl& hrefUrl)
 {
@@ -384,24 +467,33 @@ QuranReader::verseAnchorClicked(const QUrl& hrefUrl)
     int surah = hrefUrl.toString().remove("#F").toInt();
     qDebug() << "SURAH CARD:" << surah;
     emit showBetaqa(surah);
-    return;
   }
+}
 
+void
+QuranReader::pageVerseClicked(int idx)
+{
   QuranPageBrowser* senderBrowser = qobject_cast<QuranPageBrowser*>(sender());
   int browerIdx = senderBrowser == m_quranBrowsers[1];
-  int idx = hrefUrl.toString().remove('#').toInt();
-  Verse v(m_vLists[browerIdx].at(idx));
+  // pages other than the current one may be clicked in the scroll view
+  const QList<Verse> pageVerses =
+    m_scrollView ? m_quranService->verseInfoList(senderBrowser->page())
+                 : m_vLists[browerIdx];
+  if (idx >= pageVerses.size())
+    return;
+
+  Verse v(pageVerses.at(idx));
 
   QuranPageBrowser::Action chosenAction =
     senderBrowser->lmbVerseMenu(m_bookmarkService->isBookmarked(v));
 
   switch (chosenAction) {
     case QuranPageBrowser::Play:
-      selectVerse(browerIdx, idx);
+      m_navigator.navigateToVerse(v);
       m_playbackController->player()->play();
       break;
     case QuranPageBrowser::Select:
-      selectVerse(browerIdx, idx);
+      m_navigator.navigateToVerse(v);
       break;
     case QuranPageBrowser::Tafsir:
       emit showVerseTafsir(v);
@@ -428,20 +520,21 @@ QuranReader::verseAnchorClicked(const QUrl& hrefUrl)
 void
 QuranReader::verseClicked()
 {
-  // object = clickable label, parent = verse frame, verse frame name scheme =
-  // 'surah_verse'
-  QStringList data = sender()->parent()->objectName().split('_');
-  int page = data.at(0).toInt();
-  int surah = data.at(1).toInt();
-  int verse = data.at(2).toInt();
-  m_navigator.navigateToVerse(Verse(page, surah, verse));
+  // row of the clicked frame = index of its verse in the page Verse list
+  int row = sender()->property("row").toInt();
+  if (row < m_activeVList->size())
+    m_navigator.navigateToVerse(m_activeVList->at(row));
 }
 
 void
 QuranReader::gotoPage(int page)
 {
-  m_activeQuranBrowser->resetHighlight();
-  if (m_activeQuranBrowser->page() != page) {
+  if (m_activeQuranBrowser)
+    m_activeQuranBrowser->resetHighlight();
+
+  if (m_scrollView)
+    gotoScrollPage(page);
+  else if (m_activeQuranBrowser->page() != page) {
     if (m_config.readerMode() == ReaderMode::SinglePage)
       gotoSinglePage();
     else
@@ -470,6 +563,30 @@ QuranReader::gotoDoublePage(int page)
   }
 }
 
+void
+QuranReader::gotoScrollPage(int page)
+{
+  if (m_scrollView->currentPage() != page)
+    m_scrollView->scrollToPage(page);
+
+  m_activeQuranBrowser = m_scrollView->pageBrowser(page);
+  updatePageVerseInfoList();
+}
+
+void
+QuranReader::scrolledToPage(int page)
+{
+  if (page != m_currVerse.page())
+    m_navigator.navigateToPage(page);
+}
+
+void
+QuranReader::scrollPagesRecycled()
+{
+  m_activeQuranBrowser = m_scrollView->pageBrowser(m_currVerse.page());
+  highlightCurrentVerse();
+}
+
 void
 QuranReader::activeVerseChanged()
 {
@@ -477,6 +594,12 @@ QuranReader::activeVerseChanged()
   highlightCurrentVerse();
 }
 
+bool
+QuranReader::suspendedInBackground() const
+{
+  return true;
+}
+
 QuranReader::~QuranReader()
 {
   delete ui;
@@ -17,7 +17,9 @@
 #include <service/tafsirservice.h>
 #include <service/translationservice.h>
 #include <types/verse.h>
+#include <widgets/clickablelabel.h>
 #include <widgets/quranpagebrowser.h>
+#include <widgets/quranscrollview.h>
 #include <widgets/verseframe.h>
 typedef Configuration::ReaderMode ReaderMode;
 
@@ -50,6 +52,12 @@ public:
    * @brief implementation of the VerseObserver interface callback function
    */
   void activeVerseChanged();
+  /**
+   * @brief the pages & the side panel are only updated to the latest verse
+   * once the window is shown again, see Navigator::setBackground
+   * @return true
+   */
+  bool suspendedInBackground() const;
 
 public slots:
   /**
@@ -113,13 +121,19 @@ signals:
   void showVerseThoughts(const Verse& v);
 
 private slots:
+  /**
+   * @brief callback function for clicking surah frames & page headers in the
+   * QuranPageBrowser to show the surah card
+   * @param hrefUrl - "#Fsurah" where surah is the surah number
+   */
+  void verseAnchorClicked(const QUrl& hrefUrl);
   /**
    * @brief callback function for clicking verses in the QuranPageBrowser that
    * takes actions based on the chosen option in the menu
-   * @param hrefUrl - "#idx" where idx is the verse index relative to the start
-   * of the page (=index in the page Verse QList)
+   * @param idxInPage - the verse index relative to the start of the page
+   * (=index in the page Verse QList)
    */
-  void verseAnchorClicked(const QUrl& hrefUrl);
+  void pageVerseClicked(int idxInPage);
   /**
    * @brief slot to navigate to the clicked verse in the side panel and update
    * UI elements
@@ -134,6 +148,23 @@ private slots:
    * @param page - page to navigate to
    */
   void gotoDoublePage(int page);
+  /**
+   * @brief continuous scroll mode navigation, scrolls to the page unless it is
+   * already the current page of the scroll view
+   * @param page - page to navigate to
+   */
+  void gotoScrollPage(int page);
+  /**
+   * @brief slot for navigating to the page scrolled to in continuous scroll
+   * mode
+   * @param page - the page in the middle of the scroll view
+   */
+  void scrolledToPage(int page);
+  /**
+   * @brief slot for updating the active browser after the scroll view assigns
+   * new pages to its browsers
+   */
+  void scrollPagesRecycled();
 
 private:
   Ui::QuranReader* ui;
@@ -205,18 +236,43 @@ private:
    */
   void btnPrevClicked();
   /**
-   * @brief selects one of the verses in the currently displayed page(s)
-   * @param browserIdx - index of the QuranPageBrowser which contains the target
-   * verse
-   * @param IdxInPage - index of the verse relative to the start of the
-   * page
+   * @brief get the QuranPageBrowser instances used in the current ::ReaderMode
+   * @return QList of pointers to the page browsers
    */
-  void selectVerse(int browserIdx, int IdxInPage);
+  QList<QuranPageBrowser*> pageBrowsers() const;
   /**
    * @brief updates the list that containsVerse instances for verses in the
    * current page
    */
   void updatePageVerseInfoList();
+  /**
+   * @brief construct both pages in 2-page mode
+   * @details page data is loaded in the GUI thread, then the left page
+   * document is built in a worker thread while the right page document is
+   * built and the page verse lists are loaded in the GUI thread. Only setting
+   * the built documents in the page browsers waits for both
+   * @param rightPage - the (odd) page shown on the right side
+   * @param manualSz - boolean flag to force the use of the manually set
+   * fontsize
+   */
+  void constructDoublePage(int rightPage, bool manualSz);
+  /**
+   * @struct SideVerseFrame
+   * @brief widgets of a single verse row in the single page mode side panel
+   */
+  struct SideVerseFrame
+  {
+    QPointer<VerseFrame> frame;
+    QPointer<ClickableLabel> verseLb;
+    QPointer<QLabel> contentLb;
+  };
+  /**
+   * @brief create a new verse row and append it to the side panel layout
+   * @param row - index of the row in the side panel, used to map clicks back
+   * to the page verse list
+   * @return SideVerseFrame holding the created widgets
+   */
+  SideVerseFrame createVerseFrame(int row);
   /**
    * @brief QScrollArea used in single page mode to display verses &
    * translation
@@ -233,10 +289,19 @@ private:
    */
   QPointer<QuranPageBrowser> m_quranBrowsers[2];
   /**
-   * @brief QList of QFrame pointers to VerseFrame elements in the single page
-   * mode side panel
+   * @brief pointer to the QuranScrollView used in continuous scroll mode
+   */
+  QPointer<QuranScrollView> m_scrollView;
+  /**
+   * @brief pool of verse rows in the single page mode side panel, rows are
+   * refilled on page change and rows past the page verse count are hidden
+   */
+  QList<SideVerseFrame> m_verseFrameList;
+  /**
+   * @brief maps Verse::id of the verses in the side panel to their row in
+   * m_verseFrameList
    */
-  QList<QPointer<QFrame>> m_verseFrameList;
+  QHash<int, int> m_verseFrameRows;
   /**
    * @brief pointer to the currently active page Verse list
    */
@@ -142,13 +142,16 @@ BookmarksDialog::loadBookmarks(int surah)
                    tr("Verse: ") + QString::number(verse.number());
     QString glyphs =
       m_config.verseType() == Configuration::Qcf
-        ? m_glyphService->getVerseGlyphs(verse.surah(), verse.number())
+        ? m_glyphService->getVerseGlyphs(
+            verse.surah(), verse.number(), verse.page())
         : m_quranService->verseText(verse.surah(), verse.number());
 
     lbMeta->setText(info);
     lbMeta->setAlignment(Qt::AlignLeft);
 
     verseLb->setFont(QFont(fontName, 15));
+    if (m_config.verseType() == Configuration::Qcf)
+      FontManager::getInstance().pinPageFont(verseLb, verse.page());
     verseLb->setText(glyphs);
     verseLb->setAlignment(Qt::AlignLeft);
     verseLb->setWordWrap(true);
@@ -130,17 +130,22 @@ ContentDialog::setShownVerse(const Verse& newShownVerse)
   QString title = tr("Surah: ") +
                   m_quranService->surahName(m_shownVerse.surah()) + " - " +
                   tr("Verse: ") + QString::number(m_shownVerse.number());
+  QString fontFamily = FontManager::getInstance().getInstance().verseFontname(
+    m_config.verseType(), m_shownVerse.page());
   QString glyphs =
     m_config.verseType() == Configuration::Qcf
-      ? m_glyphService->getVerseGlyphs(m_shownVerse.surah(),
-                                       m_shownVerse.number())
+      ? m_glyphService->getVerseGlyphs(
+          m_shownVerse.surah(), m_shownVerse.number(), m_shownVerse.page())
       : m_quranService->verseText(m_shownVerse.surah(), m_shownVerse.number());
-  QString fontFamily = FontManager::getInstance().getInstance().verseFontname(
-    m_config.verseType(), m_shownVerse.page());
 
   ui->lbVerseInfo->setText(title);
   ui->lbVerseText->setWordWrap(true);
   ui->lbVerseText->setFont(QFont(fontFamily, m_fontSZ));
+  if (m_config.verseType() == Configuration::Qcf)
+    FontManager::getInstance().pinPageFont(ui->lbVerseText,
+                                           m_shownVerse.page());
+  else
+    FontManager::getInstance().unpinPageFont(ui->lbVerseText);
   ui->lbVerseText->setText(glyphs);
 
   if (m_shownVerse.surah() == 1 && m_shownVerse.number() == 1)
@@ -8,6 +8,7 @@
 #include <downloader/impl/contentjob.h>
 #include <downloader/impl/qcfjob.h>
 #include <downloader/impl/surahjob.h>
+#include <types/verse.h>
 #include <utils/stylemanager.h>
 
 DownloaderDialog::DownloaderDialog(QWidget* parent, JobManager* manager)
@@ -16,11 +17,16 @@ DownloaderDialog::DownloaderDialog(QWidget* parent, JobManager* manager)
   , m_jobMgr(manager)
   , m_config(Configuration::getInstance())
   , m_quranService(ServiceFactory::quranService())
+  , m_inventory(RecitationIndex::getInstance())
+  , m_completeIcon(StyleManager::getInstance().awesome().icon(
+      fa::fa_solid,
+      fa::fa_circle_check))
   , m_reciters(Reciter::reciters)
   , m_tafasir(Tafsir::tafasir)
   , m_translations(Translation::translations)
 
 {
+  Tafsir::populateTafasir();
   ui->setupUi(this);
   setWindowIcon(
     StyleManager::getInstance().awesome().icon(fa::fa_solid, fa::fa_download));
@@ -82,6 +88,11 @@ DownloaderDialog::setupConnections()
           &JobManager::downloadSpeedUpdated,
           this,
           &DownloaderDialog::updateDownloadSpeed);
+
+  connect(&m_inventory,
+          &RecitationIndex::changed,
+          this,
+          &DownloaderDialog::updateSurahStates);
 }
 
 void
@@ -108,6 +119,8 @@ DownloaderDialog::populateTreeModel()
     }
   }
   m_treeModel.invisibleRootItem()->appendRow(recitations);
+  for (int i = 0; i < m_reciters.size(); i++)
+    updateSurahStates(i);
 
   // tafsir submenu
   QStandardItem* tafsir =
@@ -153,6 +166,22 @@ DownloaderDialog::populateTreeModel()
   extras->appendRow(qcf);
 }
 
+void
+DownloaderDialog::updateSurahStates(int reciter)
+{
+  QStandardItem* reciterItem = m_treeModel.item(0)->child(reciter);
+  if (!reciterItem)
+    return;
+
+  for (int surah = 1; surah <= 114; surah++) {
+    int downloaded = m_inventory.downloadedVerses(reciter, surah);
+    int total = Verse::surahVerseCount(surah);
+    QStandardItem* item = reciterItem->child(surah - 1);
+    item->setIcon(downloaded == total ? m_completeIcon : QIcon());
+    item->setToolTip(tr("%0/%1 verses downloaded").arg(downloaded).arg(total));
+  }
+}
+
 void
 DownloaderDialog::addToDownloading(int reciter, int surah)
 {
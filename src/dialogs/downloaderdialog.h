@@ -22,6 +22,7 @@
 #include <types/tafsir.h>
 #include <types/translation.h>
 #include <utils/configuration.h>
+#include <utils/recitationindex.h>
 #include <widgets/downloadprogressbar.h>
 
 namespace Ui {
@@ -128,6 +129,11 @@ private:
    * tafsir, or translation files to add to the download queue.
    */
   void populateTreeModel();
+  /**
+   * @brief Marks the downloaded surahs of the reciter in the QTreeView.
+   * @param reciter Index of the reciter in the reciters list.
+   */
+  void updateSurahStates(int reciter);
   /**
    * @brief Adds a QFrame containing download task information and a progress
    * bar.
@@ -210,6 +216,14 @@ private:
    * services.
    */
   const QuranService* m_quranService;
+  /**
+   * @brief Reference to the RecitationIndex of the downloaded verse files.
+   */
+  RecitationIndex& m_inventory;
+  /**
+   * @brief Icon shown next to the completely downloaded surahs.
+   */
+  const QIcon m_completeIcon;
   /**
    * @brief List of Reciter objects available for download.
    */
@@ -0,0 +1,53 @@
+#include "playbackstatsdialog.h"
+#include <QDialogButtonBox>
+#include <QFontDatabase>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+PlaybackStatsDialog::PlaybackStatsDialog(QWidget* parent)
+  : QDialog(parent)
+  , m_monitor(TransitionMonitor::getInstance())
+  , m_report(new QPlainTextEdit(this))
+{
+  setWindowTitle(tr("Playback Statistics"));
+  resize(640, 360);
+
+  m_report->setReadOnly(true);
+  m_report->setLineWrapMode(QPlainTextEdit::NoWrap);
+  m_report->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+  QDialogButtonBox* buttons =
+    new QDialogButtonBox(QDialogButtonBox::Reset | QDialogButtonBox::Close);
+  connect(buttons->button(QDialogButtonBox::Reset),
+          &QPushButton::clicked,
+          &m_monitor,
+          &TransitionMonitor::reset);
+  connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::hide);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(m_report);
+  layout->addWidget(buttons);
+
+  connect(&m_monitor,
+          &TransitionMonitor::recorded,
+          this,
+          &PlaybackStatsDialog::refresh);
+}
+
+void
+PlaybackStatsDialog::refresh()
+{
+  if (!isVisible())
+    return;
+
+  QString report = m_monitor.report();
+  m_report->setPlainText(report.isEmpty() ? tr("No transitions recorded.")
+                                          : report);
+}
+
+void
+PlaybackStatsDialog::showEvent(QShowEvent* event)
+{
+  QDialog::showEvent(event);
+  refresh();
+}
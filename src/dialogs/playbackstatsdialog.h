@@ -0,0 +1,49 @@
+/**
+ * @file playbackstatsdialog.h
+ * @brief Header file for PlaybackStatsDialog
+ */
+
+#ifndef PLAYBACKSTATSDIALOG_H
+#define PLAYBACKSTATSDIALOG_H
+
+#include <QDialog>
+#include <QPlainTextEdit>
+#include <player/transitionmonitor.h>
+
+/**
+ * @class PlaybackStatsDialog
+ * @brief A debug dialog that displays the verse transition latency.
+ *
+ * This dialog shows the histograms collected by the TransitionMonitor for each
+ * reciter and refreshes them as new transitions are recorded.
+ */
+class PlaybackStatsDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Constructs a PlaybackStatsDialog object.
+   * @param parent The parent widget for this dialog.
+   */
+  explicit PlaybackStatsDialog(QWidget* parent = nullptr);
+
+private slots:
+  /**
+   * @brief Reloads the report of the TransitionMonitor if visible.
+   */
+  void refresh();
+
+protected:
+  /**
+   * @brief Refreshes the report when the dialog is shown.
+   * @param event The show event that triggered this function.
+   */
+  void showEvent(QShowEvent* event) override;
+
+private:
+  TransitionMonitor& m_monitor; ///< Reference to the TransitionMonitor.
+  QPlainTextEdit* m_report;     ///< Read-only view of the report.
+};
+
+#endif // PLAYBACKSTATSDIALOG_H
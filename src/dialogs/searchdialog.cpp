@@ -90,6 +90,13 @@ SearchDialog::getResults()
   showResults();
 }
 
+void
+SearchDialog::searchFor(const QString& text)
+{
+  ui->ledSearchBar->setText(text);
+  getResults();
+}
+
 void
 SearchDialog::verseClicked()
 {
@@ -125,9 +132,10 @@ SearchDialog::showResults()
     QString info = tr("Surah: ") +
                    m_quranService->surahNames().at(v.surah() - 1) + " - " +
                    tr("Verse: ") + QString::number(v.number());
-    QString glyphs = m_config.verseType() == Configuration::Qcf
-                       ? m_glyphService->getVerseGlyphs(v.surah(), v.number())
-                       : m_quranService->verseText(v.surah(), v.number());
+    QString glyphs =
+      m_config.verseType() == Configuration::Qcf
+        ? m_glyphService->getVerseGlyphs(v.surah(), v.number(), v.page())
+        : m_quranService->verseText(v.surah(), v.number());
 
     lbInfo->setText(info);
     lbInfo->setMaximumHeight(50);
@@ -139,6 +147,8 @@ SearchDialog::showResults()
                          QString::number(v.surah()) + '-' +
                          QString::number(v.number()));
     clkLb->setFont(QFont(fontName, 15));
+    if (m_config.verseType() == Configuration::Qcf)
+      FontManager::getInstance().pinPageFont(clkLb, v.page());
     clkLb->setText(glyphs);
     clkLb->setAlignment(Qt::AlignLeft);
     clkLb->setWordWrap(true);
@@ -51,6 +51,11 @@ public slots:
    * based on the search results.
    */
   void getResults();
+  /**
+   * @brief Slot to search for the given text with the current search options.
+   * @param text - QString of the text to search for
+   */
+  void searchFor(const QString& text);
   /**
    * @brief Slot that is called when one of the result verse labels is clicked.
    * Extracts a Verse from the emitting object name and emits
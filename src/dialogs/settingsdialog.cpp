@@ -21,6 +21,7 @@ SettingsDialog::SettingsDialog(QWidget* parent, VersePlayer* vPlayerPtr)
   , m_tafasir(Tafsir::tafasir)
   , m_translations(Translation::translations)
 {
+  Tafsir::populateTafasir();
   ui->setupUi(this);
   ui->cmbQuranFontSz->setValidator(new QIntValidator(10, 72));
   ui->cmbSideFontSz->setValidator(new QIntValidator(10, 72));
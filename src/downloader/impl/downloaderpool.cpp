@@ -0,0 +1,157 @@
+#include "downloaderpool.h"
+#include <algorithm>
+#include <utils/configuration.h>
+
+DownloaderPool::DownloaderPool(QObject* parent, SkipCheck skip)
+  : QObject(parent)
+  , m_skip(std::move(skip))
+  , m_running(false)
+  , m_completed(0)
+  , m_total(0)
+{
+  QSettings& settings = Configuration::getInstance().settings();
+  int connections = std::clamp(
+    settings.value("DownloadConnections").toInt(), 1, s_maxConnections);
+
+  // the downloaders share the connections of the manager, requests to the
+  // same host are multiplexed over http2 or reuse kept-alive connections
+  for (int slot = 0; slot < connections; slot++) {
+    TaskDownloader* downloader = new TaskDownloader(this);
+    connect(downloader, &TaskDownloader::completed, this, [this, slot]() {
+      taskFinished(slot);
+    });
+    connect(downloader,
+            &TaskDownloader::taskError,
+            this,
+            &DownloaderPool::taskFailed);
+    connect(downloader,
+            &TaskDownloader::downloadSpeedUpdated,
+            this,
+            &DownloaderPool::updateSpeed);
+    m_downloaders.append(downloader);
+  }
+  m_active.resize(connections);
+}
+
+void
+DownloaderPool::start(const QList<Task>& tasks)
+{
+  if (m_running)
+    return;
+
+  m_queue.clear();
+  for (const Task& task : tasks)
+    m_queue.enqueue(task);
+  m_completed = 0;
+  m_total = tasks.size();
+  m_running = true;
+  dispatch();
+}
+
+void
+DownloaderPool::dispatch()
+{
+  // tasks are handed out in order, the ones the skip check accepts are
+  // counted as completed without a download
+  bool skipped = false;
+  int slot;
+  while (!m_queue.isEmpty() && (slot = m_active.indexOf(nullptr)) >= 0) {
+    Task task = m_queue.dequeue();
+    if (m_skip(*task)) {
+      m_completed++;
+      skipped = true;
+      continue;
+    }
+
+    m_active[slot] = task;
+    m_downloaders.at(slot)->process(task.get(), &m_netMgr);
+  }
+
+  if (skipped)
+    emit progressed();
+  if (!m_queue.isEmpty() || !isIdle())
+    return;
+
+  m_running = false;
+  if (m_completed == m_total)
+    emit finished();
+}
+
+void
+DownloaderPool::taskFinished(int slot)
+{
+  Task task = m_active.at(slot);
+  m_active[slot].reset();
+  if (!m_running || !task)
+    return;
+
+  m_completed++;
+  emit taskCompleted(*task);
+  emit progressed();
+  dispatch();
+}
+
+void
+DownloaderPool::taskFailed()
+{
+  // the first failure fails the whole run, the other downloads are dropped
+  if (!m_running)
+    return;
+  cancel();
+  emit failed();
+}
+
+void
+DownloaderPool::stop()
+{
+  if (!m_running)
+    return;
+  cancel();
+  emit aborted();
+}
+
+void
+DownloaderPool::cancel()
+{
+  m_running = false;
+  m_queue.clear();
+  for (int slot = 0; slot < m_downloaders.size(); slot++) {
+    if (!m_active.at(slot))
+      continue;
+    m_downloaders.at(slot)->cancel();
+    m_active[slot].reset();
+  }
+}
+
+bool
+DownloaderPool::isIdle() const
+{
+  return m_active.count(nullptr) == m_active.size();
+}
+
+bool
+DownloaderPool::isRunning() const
+{
+  return m_running;
+}
+
+int
+DownloaderPool::completed() const
+{
+  return m_completed;
+}
+
+void
+DownloaderPool::updateSpeed()
+{
+  int bytes = 0;
+  for (int slot = 0; slot < m_downloaders.size(); slot++) {
+    if (m_active.at(slot))
+      bytes += m_downloaders.at(slot)->speed();
+  }
+
+  QPair<int, QString> speed = TaskDownloader::scaleSpeed(bytes);
+  emit downloadSpeedUpdated(speed.first, speed.second);
+}
+
+DownloaderPool::~DownloaderPool() {}
@@ -0,0 +1,55 @@
+#ifndef DOWNLOADERPOOL_H
+#define DOWNLOADERPOOL_H
+
+#include "taskdownloader.h"
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QObject>
+#include <QQueue>
+#include <functional>
+#include <memory>
+
+class DownloaderPool : public QObject
+{
+  Q_OBJECT
+public:
+  typedef std::shared_ptr<DownloadTask> Task;
+  typedef std::function<bool(const DownloadTask&)> SkipCheck;
+
+  DownloaderPool(QObject* parent, SkipCheck skip);
+  ~DownloaderPool();
+
+  void start(const QList<Task>& tasks);
+  void stop();
+  bool isRunning() const;
+  int completed() const;
+
+signals:
+  void downloadSpeedUpdated(int speed, QString unit);
+  void taskCompleted(const DownloadTask& task);
+  void progressed();
+  void finished();
+  void aborted();
+  void failed();
+
+private slots:
+  void updateSpeed();
+
+private:
+  void dispatch();
+  void cancel();
+  bool isIdle() const;
+  void taskFinished(int slot);
+  void taskFailed();
+  static constexpr int s_maxConnections = 8;
+  SkipCheck m_skip;
+  QNetworkAccessManager m_netMgr;
+  QList<TaskDownloader*> m_downloaders;
+  QList<Task> m_active;
+  QQueue<Task> m_queue;
+  bool m_running;
+  int m_completed;
+  int m_total;
+};
+
+#endif // DOWNLOADERPOOL_H
@@ -2,101 +2,50 @@
 #include <QApplication>
 
 QcfJob::QcfJob()
-  : m_completed(0)
-  , m_active(0)
-  , m_isDownloading(false)
-  , m_taskDlr(this)
+  : m_pool(this,
+           [](const DownloadTask& t) { return t.destination().exists(); })
 {
-  connect(&m_taskDlr, &TaskDownloader::completed, this, &QcfJob::taskFinished);
-  connect(&m_taskDlr, &TaskDownloader::taskError, this, &QcfJob::taskFailed);
-  connect(&m_taskDlr,
-          &TaskDownloader::downloadSpeedUpdated,
+  connect(&m_pool, &DownloaderPool::progressed, this, &DownloadJob::progressed);
+  connect(&m_pool, &DownloaderPool::finished, this, &DownloadJob::finished);
+  connect(&m_pool, &DownloaderPool::aborted, this, &DownloadJob::aborted);
+  connect(&m_pool, &DownloaderPool::failed, this, &DownloadJob::failed);
+  connect(&m_pool,
+          &DownloaderPool::downloadSpeedUpdated,
           this,
           &DownloadJob::downloadSpeedUpdated);
 }
 
-void
-QcfJob::enqueueTasks()
+QList<DownloaderPool::Task>
+QcfJob::tasks() const
 {
+  QList<DownloaderPool::Task> tasks;
   for (int i = 1; i <= 604; i++)
-    m_queue.enqueue(QcfTask(i));
-}
-
-void
-QcfJob::processTasks()
-{
-  if (m_queue.isEmpty()) {
-    m_isDownloading = false;
-    return;
-  }
-
-  m_active = m_queue.dequeue();
-  while (m_active.destination().exists()) {
-    m_completed++;
-    if (m_completed == 604) {
-      emit DownloadJob::progressed();
-      emit DownloadJob::finished();
-    }
-
-    if (m_queue.isEmpty())
-      return;
-
-    m_active = m_queue.dequeue();
-  }
-
-  m_taskDlr.process(&m_active, &m_netMgr);
-}
-
-void
-QcfJob::taskFinished()
-{
-  m_completed++;
-  emit DownloadJob::progressed();
-  if (m_completed == 604)
-    emit DownloadJob::finished();
-  processTasks();
-}
-
-void
-QcfJob::taskFailed()
-{
-  m_isDownloading = false;
-  m_queue.clear();
-  emit DownloadJob::failed();
+    tasks.append(std::make_shared<QcfTask>(i));
+  return tasks;
 }
 
 void
 QcfJob::start()
 {
-  if (m_isDownloading)
-    return;
-  if (m_queue.isEmpty())
-    enqueueTasks();
-  m_isDownloading = true;
-  processTasks();
+  m_pool.start(tasks());
 }
 
 void
 QcfJob::stop()
 {
-  if (!m_isDownloading)
-    return;
-  m_taskDlr.cancel();
-  m_isDownloading = false;
-  m_queue.clear();
-  emit DownloadJob::aborted();
+  m_pool.stop();
 }
 
 bool
 QcfJob::isDownloading()
 {
-  return m_isDownloading;
+  return m_pool.isRunning();
 }
 
 int
 QcfJob::completed()
 {
-  return m_completed;
+  return m_pool.completed();
 }
 
 int
@@ -1,8 +1,7 @@
 #ifndef QCFJOB_H
 #define QCFJOB_H
 
-#include "taskdownloader.h"
-#include <QQueue>
+#include "downloaderpool.h"
 #include <downloader/downloadjob.h>
 #include <downloader/impl/qcftask.h>
 
@@ -21,20 +20,10 @@ public:
   Type type() override;
   QString name() override;
 
-  void enqueueTasks();
-
-private slots:
-  void processTasks();
-  void taskFinished();
-  void taskFailed();
+  QList<DownloaderPool::Task> tasks() const;
 
 private:
-  TaskDownloader m_taskDlr;
-  QQueue<QcfTask> m_queue;
-  QNetworkAccessManager m_netMgr;
-  QcfTask m_active;
-  bool m_isDownloading;
-  int m_completed;
+  DownloaderPool m_pool;
 };
 
 #endif // QCFJOB_H
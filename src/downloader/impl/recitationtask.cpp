@@ -63,4 +63,10 @@ RecitationTask::destination() const
                QString::number(m_verse).rightJustified(3, '0'))));
 }
 
+int
+RecitationTask::verse() const
+{
+  return m_verse;
+}
+
 RecitationTask::~RecitationTask() {}
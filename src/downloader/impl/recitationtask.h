@@ -21,6 +21,7 @@ public:
 
   QUrl url() const override;
   QFileInfo destination() const override;
+  int verse() const;
 
 private:
   const QDir& m_downloadsDir = DirManager::getInstance().downloadsDir();
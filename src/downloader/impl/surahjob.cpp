@@ -4,105 +4,69 @@
 SurahJob::SurahJob(int reciter, int surah)
   : m_reciter(reciter)
   , m_surah(surah)
-  , m_completed(0)
-  , m_isDownloading(false)
-  , m_taskDlr(this)
+  , m_pool(this, [this](const DownloadTask& t) { return isDownloaded(t); })
   , m_quranService(ServiceFactory::quranService())
   , m_surahCount(Verse::surahVerseCount(surah))
   , m_reciters(Reciter::reciters)
+  , m_inventory(RecitationIndex::getInstance())
 {
   connect(
-    &m_taskDlr, &TaskDownloader::completed, this, &SurahJob::taskFinished);
-  connect(&m_taskDlr, &TaskDownloader::taskError, this, &SurahJob::taskFailed);
-  connect(&m_taskDlr,
-          &TaskDownloader::downloadSpeedUpdated,
+    &m_pool, &DownloaderPool::taskCompleted, this, &SurahJob::taskCompleted);
+  connect(&m_pool, &DownloaderPool::progressed, this, &DownloadJob::progressed);
+  connect(&m_pool, &DownloaderPool::finished, this, &DownloadJob::finished);
+  connect(&m_pool, &DownloaderPool::aborted, this, &DownloadJob::aborted);
+  connect(&m_pool, &DownloaderPool::failed, this, &DownloadJob::failed);
+  connect(&m_pool,
+          &DownloaderPool::downloadSpeedUpdated,
           this,
           &DownloadJob::downloadSpeedUpdated);
 }
 
-void
-SurahJob::enqueueTasks()
+QList<DownloaderPool::Task>
+SurahJob::tasks() const
 {
+  QList<DownloaderPool::Task> tasks;
   for (int i = 1; i <= m_surahCount; i++)
-    m_queue.enqueue(RecitationTask(m_reciter, m_surah, i));
+    tasks.append(std::make_shared<RecitationTask>(m_reciter, m_surah, i));
+  return tasks;
 }
 
-void
-SurahJob::processTasks()
+bool
+SurahJob::isDownloaded(const DownloadTask& task) const
 {
-  if (m_queue.isEmpty()) {
-    m_isDownloading = false;
-    return;
-  }
-
-  m_active = m_queue.dequeue();
-  while (m_active.destination().exists()) {
-    m_completed++;
-    if (m_completed == m_surahCount) {
-      emit DownloadJob::progressed();
-      emit DownloadJob::finished();
-      m_isDownloading = false;
-    }
-
-    if (m_queue.isEmpty())
-      return;
-
-    m_active = m_queue.dequeue();
-  }
-
-  m_taskDlr.process(&m_active, &m_netMgr);
+  const RecitationTask& verse = static_cast<const RecitationTask&>(task);
+  return m_inventory.hasVerse(m_reciter, m_surah, verse.verse());
 }
 
 void
-SurahJob::taskFinished()
+SurahJob::taskCompleted(const DownloadTask& task)
 {
-  m_completed++;
-  emit DownloadJob::progressed();
-  if (m_completed == m_surahCount)
-    emit DownloadJob::finished();
-  processTasks();
+  const RecitationTask& verse = static_cast<const RecitationTask&>(task);
+  m_inventory.markDownloaded(m_reciter, m_surah, verse.verse());
 }
 
 void
 SurahJob::start()
 {
-  if (m_isDownloading)
-    return;
-  if (m_queue.isEmpty())
-    enqueueTasks();
-  m_isDownloading = true;
-  processTasks();
+  m_pool.start(tasks());
 }
 
 void
 SurahJob::stop()
 {
-  if (!m_isDownloading)
-    return;
-  m_taskDlr.cancel();
-  m_isDownloading = false;
-  m_queue.clear();
-  emit DownloadJob::aborted();
-}
-
-void
-SurahJob::taskFailed()
-{
-  m_isDownloading = false;
-  m_queue.clear();
-  emit DownloadJob::failed();
+  m_pool.stop();
 }
 
 bool
 SurahJob::isDownloading()
 {
-  return m_isDownloading;
+  return m_pool.isRunning();
 }
 
 int
 SurahJob::completed()
 {
-  return m_completed;
+  return m_pool.completed();
 }
 
 int
@@ -1,11 +1,10 @@
 #ifndef SURAHJOB_H
 #define SURAHJOB_H
 
+#include "downloaderpool.h"
 #include "recitationtask.h"
-#include "taskdownloader.h"
-#include <QQueue>
-#include <QTime>
 #include <downloader/downloadjob.h>
+#include <utils/recitationindex.h>
 
 class SurahJob : public DownloadJob
 {
@@ -22,26 +21,21 @@ public:
   Type type() override;
   QString name() override;
 
-  void enqueueTasks();
+  QList<DownloaderPool::Task> tasks() const;
   int reciter() const;
   int surah() const;
 
 private slots:
-  void processTasks();
-  void taskFinished();
-  void taskFailed();
+  void taskCompleted(const DownloadTask& task);
 
 private:
+  bool isDownloaded(const DownloadTask& task) const;
   const QuranService* m_quranService;
   QList<Reciter>& m_reciters;
-  TaskDownloader m_taskDlr;
-  QQueue<RecitationTask> m_queue;
-  QNetworkAccessManager m_netMgr;
-  RecitationTask m_active;
-  bool m_isDownloading;
+  RecitationIndex& m_inventory;
+  DownloaderPool m_pool;
   int m_reciter;
   int m_surah;
-  int m_completed;
   int m_surahCount;
 };
 
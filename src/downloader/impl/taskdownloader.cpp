@@ -7,6 +7,7 @@ TaskDownloader::TaskDownloader(QObject* parent)
   , m_task(nullptr)
   , m_bytes(0)
   , m_total(1)
+  , m_speed(0)
 {
 }
 
@@ -28,6 +29,8 @@ TaskDownloader::process(DownloadTask* task, QNetworkAccessManager* manager)
   }
 
   QNetworkRequest req(m_task->url());
+  req.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+  m_speed = 0;
   m_reply = manager->get(req);
   m_reply->ignoreSslErrors();
   m_startTime = QTime::currentTime();
@@ -59,18 +62,26 @@ TaskDownloader::taskProgress(qint64 bytes, qint64 total)
   if (secs < 1)
     secs = 1;
 
-  int speedPerSec = bytes / secs;
+  m_speed = bytes / secs;
+  QPair<int, QString> speed = scaleSpeed(m_speed);
+  emit downloadSpeedUpdated(speed.first, speed.second);
+}
+
+QPair<int, QString>
+TaskDownloader::scaleSpeed(int bytesPerSec)
+{
+  int speed = bytesPerSec;
   QString unit = qApp->translate("DownloadManager", "bytes");
-  if (speedPerSec >= 1024) {
+  if (speed >= 1024) {
     unit = qApp->translate("DownloadManager", "KB");
-    speedPerSec /= 1024;
+    speed /= 1024;
   }
-  if (speedPerSec >= 1024) {
+  if (speed >= 1024) {
     unit = qApp->translate("DownloadManager", "MB");
-    speedPerSec /= 1024;
+    speed /= 1024;
   }
 
-  emit downloadSpeedUpdated(speedPerSec, unit);
+  return { speed, unit };
 }
 
 void
@@ -125,4 +136,10 @@ TaskDownloader::total() const
   return m_total;
 }
 
+int
+TaskDownloader::speed() const
+{
+  return m_speed;
+}
+
 TaskDownloader::~TaskDownloader() {}
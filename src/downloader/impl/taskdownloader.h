@@ -3,6 +3,7 @@
 
 #include <QNetworkReply>
 #include <QObject>
+#include <QPair>
 #include <QTime>
 #include <downloader/downloadtask.h>
 
@@ -18,6 +19,9 @@ public:
 
   int bytes() const;
   int total() const;
+  int speed() const;
+
+  static QPair<int, QString> scaleSpeed(int bytesPerSec);
 
 signals:
   void downloadSpeedUpdated(int speed, QString unit);
@@ -37,6 +41,7 @@ private:
   QNetworkReply* m_reply;
   int m_bytes;
   int m_total;
+  int m_speed;
 };
 
 #endif // TASKDOWNLOADER_H
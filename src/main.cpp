@@ -4,18 +4,338 @@
  */
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QJsonObject>
 #include <QSplashScreen>
+#include <QTextStream>
 #include <components/mainwindow.h>
+#include <optional>
+#include <player/recitationpack.h>
+#include <server/apiserver.h>
 #include <types/reciter.h>
 #include <types/tafsir.h>
 #include <types/translation.h>
+#include <types/verse.h>
+#include <utils/appinfo.h>
+#include <utils/catalogcache.h>
 #include <utils/configuration.h>
+#include <utils/corpusquery.h>
 #include <utils/dirmanager.h>
 #include <utils/fontmanager.h>
 #include <utils/logger.h>
+#include <utils/pageexporter.h>
 #include <utils/shortcuthandler.h>
+#include <utils/singleinstance.h>
+#include <utils/startupreport.h>
+#include <utils/startupscheduler.h>
 #include <utils/stylemanager.h>
 
+/**
+ * @brief export pages to images or a PDF file without showing the reader
+ * @param range - page range in the form 'first-last' or a single page
+ * @param format - 'png' or 'pdf'
+ * @param dpi - output resolution in dots per inch
+ * @param output - output directory (png) or file (pdf)
+ * @return exit code, 0 if all the pages were exported
+ */
+static int
+exportPages(const QString& range,
+            const QString& format,
+            int dpi,
+            const QString& output)
+{
+  QTextStream err(stderr);
+  QStringList bounds = range.split('-');
+  int first = bounds.first().toInt();
+  int last = bounds.last().toInt();
+  if (bounds.size() > 2 || first < 1 || last > 604 || first > last) {
+    err << "invalid page range: " << range << Qt::endl;
+    return 1;
+  }
+
+  if (format != "png" && format != "pdf") {
+    err << "unsupported export format: " << format << Qt::endl;
+    return 1;
+  }
+
+  if (dpi <= 0) {
+    err << "invalid dpi: " << dpi << Qt::endl;
+    return 1;
+  }
+
+  StyleManager::getInstance().loadTheme();
+  FontManager::getInstance().loadFonts();
+
+  PageExporter exporter(first,
+                        last,
+                        format == "pdf" ? PageExporter::Pdf : PageExporter::Png,
+                        dpi,
+                        output);
+  return exporter.run() ? 0 : 1;
+}
+
+/**
+ * @brief check whether one of the given options is passed, used to pick a
+ * headless mode before any application instance is created
+ * @param argc - the number of arguments passed to the application
+ * @param argv - command line arguments passed to the application
+ * @param options - long option names including the leading dashes
+ * @return boolean indicating whether one of the options is passed
+ */
+static bool
+hasOption(int argc, char* argv[], std::initializer_list<const char*> options)
+{
+  for (int i = 1; i < argc; i++) {
+    QByteArray arg(argv[i]);
+    for (const char* opt : options) {
+      if (arg == opt || arg.startsWith(QByteArray(opt) + '='))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief write verses, translations and tafsir to stdout without creating
+ * any widgets or loading fonts and styles
+ * @param argc - the number of arguments passed to the application
+ * @param argv - command line arguments passed to the application
+ * @return exit code, 0 if the query succeeded
+ */
+static int
+runQuery(int argc, char* argv[])
+{
+  QCoreApplication a(argc, argv);
+  AppInfo::apply();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+    "Write Quran verses to stdout without starting the reader.");
+  parser.addHelpOption();
+  QCommandLineOption queryOpt(
+    "query",
+    "Write the verses in <range>: all, 2, 2:255, 2:255-257, 2-3 or "
+    "2:255-3:10.",
+    "range");
+  QCommandLineOption searchOpt(
+    "search", "Write the verses containing <text>.", "text");
+  QCommandLineOption wholeWordOpt("whole-word", "Search for whole words.");
+  QCommandLineOption translationOpt(
+    "translation", "Include the translation with <id>.", "id");
+  QCommandLineOption tafsirOpt("tafsir", "Include the tafsir with <id>.", "id");
+  QCommandLineOption annotatedOpt("annotated", "Write the annotated text.");
+  QCommandLineOption formatOpt(
+    "format", "Output format, text or json.", "format", "text");
+  parser.addOptions({ queryOpt,
+                      searchOpt,
+                      wholeWordOpt,
+                      translationOpt,
+                      tafsirOpt,
+                      annotatedOpt,
+                      formatOpt });
+  parser.process(a);
+
+  QTextStream err(stderr);
+  QString format = parser.value(formatOpt);
+  if (format != "text" && format != "json") {
+    err << "unsupported output format: " << format << Qt::endl;
+    return 1;
+  }
+
+  Configuration::getInstance().setVerseType(parser.isSet(annotatedOpt)
+                                              ? Configuration::Annotated
+                                              : Configuration::Uthmanic);
+  CatalogCache::getInstance().load();
+
+  CorpusQuery query(format == "json" ? CorpusQuery::Json : CorpusQuery::Text);
+  if (parser.isSet(translationOpt) &&
+      !query.setTranslation(parser.value(translationOpt))) {
+    err << "translation not available: " << parser.value(translationOpt)
+        << Qt::endl;
+    return 1;
+  }
+
+  if (parser.isSet(tafsirOpt) && !query.setTafsir(parser.value(tafsirOpt))) {
+    err << "tafsir not available: " << parser.value(tafsirOpt) << Qt::endl;
+    return 1;
+  }
+
+  if (parser.isSet(searchOpt)) {
+    query.search(parser.value(searchOpt), parser.isSet(wholeWordOpt));
+    return 0;
+  }
+
+  if (!query.query(parser.value(queryOpt))) {
+    err << "invalid verse range: " << parser.value(queryOpt) << Qt::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief serve the local HTTP API without creating any widgets, see ApiServer
+ * @param argc - the number of arguments passed to the application
+ * @param argv - command line arguments passed to the application
+ * @return exit code, 0 if the server stopped normally
+ */
+static int
+runServer(int argc, char* argv[])
+{
+  QCoreApplication a(argc, argv);
+  AppInfo::apply();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+    "Serve verse, translation and tafsir lookups as JSON on localhost.");
+  parser.addHelpOption();
+  QCommandLineOption serveOpt("serve", "Listen on <port>.", "port");
+  QCommandLineOption workersOpt(
+    "api-workers", "Number of worker threads.", "count", "0");
+  QCommandLineOption cacheOpt(
+    "api-cache", "Number of cached responses.", "count", "4096");
+  parser.addOptions({ serveOpt, workersOpt, cacheOpt });
+  parser.process(a);
+
+  QTextStream err(stderr);
+  int port = parser.value(serveOpt).toInt();
+  if (port < 1 || port > 65535) {
+    err << "invalid port: " << parser.value(serveOpt) << Qt::endl;
+    return 1;
+  }
+
+  CatalogCache::getInstance().load();
+  ApiServer server(parser.value(workersOpt).toInt(),
+                   parser.value(cacheOpt).toInt());
+  if (!server.start(port))
+    return 1;
+
+  return a.exec();
+}
+
+/**
+ * @brief pack or unpack the verse recitations of a reciter without creating
+ * any widgets, see RecitationPack
+ * @param argc - the number of arguments passed to the application
+ * @param argv - command line arguments passed to the application
+ * @return exit code, 0 if all the surahs were processed
+ */
+static int
+runPacker(int argc, char* argv[])
+{
+  QCoreApplication a(argc, argv);
+  AppInfo::apply();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+    "Pack the downloaded verse recitations into a file per surah.");
+  parser.addHelpOption();
+  QCommandLineOption packOpt(
+    "pack",
+    "Pack the complete surahs of <reciter> (directory name), or 'all'.",
+    "reciter");
+  QCommandLineOption unpackOpt(
+    "unpack",
+    "Write back the verse files of <reciter> (directory name), or 'all'.",
+    "reciter");
+  QCommandLineOption surahOpt("surah", "Only process <surah>.", "surah");
+  parser.addOptions({ packOpt, unpackOpt, surahOpt });
+  parser.process(a);
+
+  QTextStream out(stdout);
+  QTextStream err(stderr);
+  bool pack = parser.isSet(packOpt);
+  QString id = parser.value(pack ? packOpt : unpackOpt);
+  int first = 1, last = 114;
+  if (parser.isSet(surahOpt)) {
+    first = last = parser.value(surahOpt).toInt();
+    if (first < 1 || first > 114) {
+      err << "invalid surah: " << parser.value(surahOpt) << Qt::endl;
+      return 1;
+    }
+  }
+
+  CatalogCache::getInstance().load();
+  Reciter::populateReciters();
+
+  bool found = false, failed = false;
+  for (const Reciter& r : std::as_const(Reciter::reciters)) {
+    if (id != "all" && r.baseDirName() != id)
+      continue;
+
+    found = true;
+    QDir dir(DirManager::getInstance().downloadsDir().absoluteFilePath(
+      "recitations/" + r.baseDirName()));
+    int processed = 0;
+    for (int surah = first; surah <= last; surah++) {
+      bool packed = dir.exists(RecitationPack::fileName(surah));
+      if (pack && !packed) {
+        // incomplete surahs are skipped, a complete one fails on I/O errors
+        if (!RecitationPack::hasVerseFiles(dir, surah))
+          continue;
+        bool written = RecitationPack::pack(dir, surah);
+        failed = failed || !written;
+        processed += written;
+      } else if (!pack && packed) {
+        bool unpacked = RecitationPack::unpack(dir, surah);
+        failed = failed || !unpacked;
+        processed += unpacked;
+      }
+    }
+
+    out << r.baseDirName() << ": " << processed << " surahs "
+        << (pack ? "packed" : "unpacked") << Qt::endl;
+  }
+
+  if (!found) {
+    err << "unknown reciter: " << id << Qt::endl;
+    return 1;
+  }
+
+  return failed ? 1 : 0;
+}
+
+/**
+ * @brief build the request handled by the running instance from the command
+ * line, see SingleInstance
+ * @param parser - QCommandLineParser of the processed command line
+ * @return QJsonObject of the request, std::nullopt if an argument is invalid
+ */
+static std::optional<QJsonObject>
+instanceRequest(const QCommandLineParser& parser)
+{
+  QTextStream err(stderr);
+  QJsonObject request;
+  if (parser.isSet("open")) {
+    QStringList parts = parser.value("open").split(':');
+    int surah = parts.first().toInt();
+    int number = parts.size() == 2 ? parts.last().toInt() : 1;
+    if (parts.size() > 2 || number < 1 ||
+        number > Verse::surahVerseCount(surah)) {
+      err << "invalid verse: " << parser.value("open") << Qt::endl;
+      return std::nullopt;
+    }
+    request["verse"] = QString("%0:%1").arg(surah).arg(number);
+  }
+
+  if (parser.isSet("page")) {
+    int page = parser.value("page").toInt();
+    if (page < 1 || page > 604) {
+      err << "invalid page: " << parser.value("page") << Qt::endl;
+      return std::nullopt;
+    }
+    request["page"] = page;
+  }
+
+  if (parser.isSet("play"))
+    request["play"] = true;
+  if (parser.isSet("find"))
+    request["find"] = parser.value("find");
+
+  return request;
+}
+
 /**
  * @brief application entry point
  * @param argc - the number of arguments passed to the application
@@ -25,29 +345,154 @@
 int
 main(int argc, char* argv[])
 {
+  if (hasOption(argc, argv, { "--serve" }))
+    return runServer(argc, argv);
+  if (hasOption(argc, argv, { "--query", "--search" }))
+    return runQuery(argc, argv);
+  if (hasOption(argc, argv, { "--pack", "--unpack" }))
+    return runPacker(argc, argv);
+
+  StartupReport& startup = StartupReport::getInstance();
+  StartupReport::Phase appPhase("QApplication");
   QApplication a(argc, argv);
-  QApplication::setApplicationName("Quran Companion");
-  QApplication::setOrganizationName("0xzer0x");
-  QApplication::setApplicationVersion("1.3.0");
+  appPhase.end();
+  AppInfo::apply();
 
-  QSplashScreen splash(QPixmap(":/resources/splash.png"));
-  splash.show();
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  parser.addVersionOption();
+  QCommandLineOption exportOpt(
+    "export-pages",
+    "Export the pages in <range> (first-last) and exit, run with "
+    "'-platform offscreen' to export without a display.",
+    "range");
+  QCommandLineOption formatOpt(
+    "format", "Export format, png or pdf.", "format", "png");
+  QCommandLineOption dpiOpt("dpi", "Export resolution.", "dpi", "150");
+  QCommandLineOption outputOpt(
+    "output", "Export directory (png) or file (pdf).", "path", "mushaf");
+  QCommandLineOption startupReportOpt(
+    "startup-report",
+    "Write the startup phase timings as JSON to <file>.",
+    "file");
+  QCommandLineOption openOpt(
+    "open", "Open the verse <surah:ayah> or the surah <surah>.", "verse");
+  QCommandLineOption pageOpt("page", "Open <page>.", "page");
+  QCommandLineOption playOpt("play", "Start the recitation playback.");
+  QCommandLineOption findOpt(
+    "find", "Open the search dialog and search for <text>.", "text");
+  QCommandLineOption newInstanceOpt(
+    "new-instance", "Don't hand off to an already running instance.");
+  QCommandLineOption apiPortOpt(
+    "api-port", "Serve the local HTTP API on <port>.", "port");
+  parser.addOptions({ exportOpt,
+                      formatOpt,
+                      dpiOpt,
+                      outputOpt,
+                      startupReportOpt,
+                      openOpt,
+                      pageOpt,
+                      playOpt,
+                      findOpt,
+                      newInstanceOpt,
+                      apiPortOpt });
+  parser.process(a);
+  startup.setJsonPath(parser.value(startupReportOpt));
+
+  std::optional<QJsonObject> request = instanceRequest(parser);
+  if (!request.has_value())
+    return 1;
 
+  // the request is handed to the running instance before loading anything
+  bool handOff = !parser.isSet(exportOpt) && !parser.isSet(newInstanceOpt) &&
+                 !parser.isSet(startupReportOpt);
+  if (handOff && SingleInstance::getInstance().forward(request.value()))
+    return 0;
+
+  StartupReport::Phase loggerPhase("Logger::startLogger");
   Logger::startLogger(DirManager::getInstance().configDir().absolutePath());
   Logger::attach();
+  loggerPhase.end();
 
-  Configuration::getInstance().loadUiTranslation();
-  ShortcutHandler::getInstance().populateDescriptionMap();
-  StyleManager::getInstance().loadTheme();
-  FontManager::getInstance().loadFonts();
+  if (parser.isSet(exportOpt)) {
+    int exitcode = exportPages(parser.value(exportOpt),
+                               parser.value(formatOpt),
+                               parser.value(dpiOpt).toInt(),
+                               parser.value(outputOpt));
+    Logger::stopLogger();
+    return exitcode;
+  }
 
-  Tafsir::populateTafasir();
-  Translation::populateTranslations();
-  Reciter::populateReciters();
+  StartupReport::Phase splashPhase("QSplashScreen");
+  QSplashScreen splash(QPixmap(":/resources/splash.png"));
+  splash.show();
+  splashPhase.end();
+
+  {
+    StartupReport::Phase phase("Configuration::loadUiTranslation");
+    Configuration::getInstance().loadUiTranslation();
+  }
+  {
+    StartupReport::Phase phase("ShortcutHandler::populateDescriptionMap");
+    ShortcutHandler::getInstance().populateDescriptionMap();
+  }
+  {
+    StartupReport::Phase phase("StyleManager::loadTheme");
+    StyleManager::getInstance().loadTheme();
+  }
+  {
+    StartupReport::Phase phase("FontManager::loadFonts");
+    FontManager::getInstance().loadFonts();
+  }
+  bool catalogsCached;
+  {
+    StartupReport::Phase phase("CatalogCache::load");
+    catalogsCached = CatalogCache::getInstance().load();
+  }
+  {
+    StartupReport::Phase phase("Translation::populateTranslations");
+    Translation::populateTranslations();
+  }
+  {
+    StartupReport::Phase phase("Reciter::populateReciters");
+    Reciter::populateReciters();
+  }
 
+  StartupReport::Phase windowPhase("MainWindow");
   MainWindow w(nullptr);
   splash.finish(&w);
   w.show();
+  windowPhase.end();
+
+  SingleInstance& instance = SingleInstance::getInstance();
+  QObject::connect(&instance,
+                   &SingleInstance::requestReceived,
+                   &w,
+                   &MainWindow::handleRequest);
+  instance.listen();
+  if (!request->isEmpty())
+    w.handleRequest(request.value());
+
+  // the tafsir catalog is only needed by the content & download dialogs,
+  // the report is finished once the deferred startup work is done
+  StartupScheduler& scheduler = StartupScheduler::getInstance();
+  scheduler.defer("Tafsir::populateTafasir", &Tafsir::populateTafasir);
+  if (!catalogsCached) {
+    scheduler.defer("CatalogCache::save",
+                    []() { CatalogCache::getInstance().save(); });
+  }
+
+  ApiServer apiServer;
+  int apiPort = parser.value(apiPortOpt).toInt();
+  if (apiPort > 0 && apiPort <= 65535) {
+    scheduler.defer("ApiServer::start",
+                    [&apiServer, apiPort]() { apiServer.start(apiPort); });
+  }
+  QObject::connect(&scheduler,
+                   &StartupScheduler::finished,
+                   &a,
+                   [&startup]() { startup.finish(); });
+  scheduler.start();
 
   int exitcode = a.exec();
   Logger::stopLogger();
@@ -30,8 +30,30 @@ Navigator::removeObserver(VerseObserver* observer)
 void
 Navigator::notifyObservers()
 {
-  for (VerseObserver* observer : m_verseObservers)
-    observer->activeVerseChanged();
+  for (VerseObserver* observer : m_verseObservers) {
+    if (m_background && observer->suspendedInBackground())
+      m_pending = true;
+    else
+      observer->activeVerseChanged();
+  }
+}
+
+void
+Navigator::setBackground(bool background)
+{
+  if (background == m_background)
+    return;
+
+  m_background = background;
+  if (m_background || !m_pending)
+    return;
+
+  // only the latest verse is applied, whatever was skipped meanwhile
+  m_pending = false;
+  for (VerseObserver* observer : m_verseObservers) {
+    if (observer->suspendedInBackground())
+      observer->activeVerseChanged();
+  }
 }
 
 void
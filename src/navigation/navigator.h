@@ -40,6 +40,16 @@ public:
    * @brief Notifies all registered observers of a verse change.
    */
   void notifyObservers();
+  /**
+   * @brief Enters or leaves background mode, e.g. while the window is hidden
+   * in the tray during playback.
+   *
+   * In background mode, observers that are suspended in background are not
+   * notified of verse changes. Leaving background mode notifies them once if
+   * the verse changed in the meantime.
+   * @param background True to enter background mode, false to leave it.
+   */
+  void setBackground(bool background);
   /**
    * @brief Navigates to a specific verse.
    * @param verse The Verse object representing the target verse.
@@ -98,6 +108,9 @@ private:
                                       ///< accessing verse information.
   QList<VerseObserver*>
     m_verseObservers; ///< List of observers to be notified of verse changes.
+  bool m_background = false; ///< Indicates whether UI observers are suspended.
+  bool m_pending = false;    ///< Indicates whether suspended observers
+                             ///< missed a verse change.
 };
 
 #endif // NAVIGATOR_H
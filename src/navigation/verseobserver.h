@@ -18,6 +18,14 @@ public:
    * notifications.
    */
   virtual void activeVerseChanged() = 0;
+  /**
+   * @brief Indicates whether the observer only updates the UI.
+   *
+   * UI observers are not notified while the Navigator is in background mode,
+   * they are notified once of the latest verse when it is left.
+   * @return True if the observer can be suspended, false by default.
+   */
+  virtual bool suspendedInBackground() const { return false; }
   /**
    * @brief Virtual destructor for the VerseObserver class.
    */
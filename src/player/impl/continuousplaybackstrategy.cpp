@@ -20,9 +20,52 @@ ContinuousPlaybackStrategy::stop()
   return m_quranService->firstInPage(current.page());
 }
 
+int
+ContinuousPlaybackStrategy::currentIndex() const
+{
+  if (!m_plan.has_value())
+    m_plan = PlaybackPlan::continuous();
+
+  const Verse& current = Verse::getCurrent();
+  if (m_index < 0 || m_index >= m_plan->size() ||
+      m_plan->verseAt(m_index) != current)
+    m_index = m_plan->indexOf(current);
+
+  return m_index;
+}
+
 std::optional<Verse> ContinuousPlaybackStrategy::nextVerse()
 {
-  return m_quranService->next(Verse::getCurrent(), true);
+  int idx = currentIndex();
+  if (idx < 0 || idx + 1 >= m_plan->size())
+    return std::nullopt;
+
+  m_index = idx + 1;
+  return m_plan->verseAt(m_index);
+}
+
+std::optional<Verse>
+ContinuousPlaybackStrategy::peekNextVerse() const
+{
+  QList<Verse> next = upcomingVerses(1);
+  if (next.isEmpty())
+    return std::nullopt;
+
+  return next.first();
+}
+
+QList<Verse>
+ContinuousPlaybackStrategy::upcomingVerses(int count) const
+{
+  int idx = currentIndex();
+  return idx < 0 ? QList<Verse>() : m_plan->upcoming(idx, count);
+}
+
+int
+ContinuousPlaybackStrategy::remainingVerses() const
+{
+  int idx = currentIndex();
+  return idx < 0 ? 0 : m_plan->size() - idx - 1;
 }
 
 bool
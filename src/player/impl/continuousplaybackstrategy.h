@@ -1,6 +1,7 @@
 #ifndef CONTINUOUSPLAYBACKSTRATEGY_H
 #define CONTINUOUSPLAYBACKSTRATEGY_H
 
+#include <player/playbackplan.h>
 #include <player/playbackstrategy.h>
 #include <player/verseplayer.h>
 
@@ -10,6 +11,10 @@ class ContinuousPlaybackStrategy : public PlaybackStrategy
 {
 private:
   QuranService* m_quranService;
+  // the plan of the whole Quran is compiled on first use
+  mutable std::optional<PlaybackPlan> m_plan;
+  mutable int m_index = 0;
+  int currentIndex() const;
 
 public:
   ContinuousPlaybackStrategy();
@@ -17,6 +22,9 @@ public:
   virtual Verse start() override;
   virtual Verse stop() override;
   virtual std::optional<Verse> nextVerse() override;
+  std::optional<Verse> peekNextVerse() const override;
+  QList<Verse> upcomingVerses(int count) const override;
+  int remainingVerses() const override;
   bool verseInRange(const Verse&) override;
 };
 
@@ -1,25 +1,23 @@
 #include "setplaybackstrategy.h"
 
-#include <service/servicefactory.h>
+#include <algorithm>
 
 SetPlaybackStrategy::SetPlaybackStrategy(Verse start,
                                          Verse end,
                                          int repeatCount,
                                          int verseFrequency)
-  : m_currentIteration(0)
-  , m_currentRepetition(0)
-  , m_repeatCount(repeatCount)
-  , m_verseFrequency(verseFrequency)
+  : m_plan(PlaybackPlan::range(start, end, repeatCount, verseFrequency))
+  , m_index(0)
+  , m_current(Verse::getCurrent())
   , m_start(start)
   , m_end(end)
-  , m_current(Verse::getCurrent())
-  , m_quranService(ServiceFactory::quranService())
 {
 }
 
 Verse
 SetPlaybackStrategy::start()
 {
+  m_index = 0;
   return m_start;
 }
 
@@ -29,27 +27,68 @@ SetPlaybackStrategy::stop()
   return m_start;
 }
 
+int
+SetPlaybackStrategy::currentIndex() const
+{
+  if (m_plan.size() == 0)
+    return -1;
+  if (m_plan.verseAt(m_index) == m_current)
+    return m_index;
+
+  // the reader navigated within the range, continue from the same verse in
+  // the current iteration
+  int from = m_index - m_index % m_plan.iterationLength();
+  int idx = m_plan.indexOf(m_current, from);
+  if (idx == -1)
+    idx = m_plan.indexOf(m_current);
+  if (idx != -1)
+    m_index = idx;
+
+  return m_index;
+}
+
 std::optional<Verse>
 SetPlaybackStrategy::nextVerse()
 {
-  bool iterationDone = m_current == m_end;
-  bool setDone = iterationDone && (m_currentIteration + 1) == m_repeatCount;
-  bool verseRepeatDone = (m_currentRepetition + 1) == m_verseFrequency;
-
-  if (verseRepeatDone) {
-    m_currentRepetition = 0;
-    if (setDone) {
-      return std::nullopt;
-    } else if (iterationDone) {
-      m_currentIteration++;
-      return m_start;
-    } else {
-      return m_quranService->next(m_current, true);
-    }
-  } else {
-    m_currentRepetition++;
-    return m_current;
-  }
+  int idx = currentIndex();
+  if (idx + 1 >= m_plan.size())
+    return std::nullopt;
+
+  m_index = idx + 1;
+  return m_plan.verseAt(m_index);
+}
+
+std::optional<Verse>
+SetPlaybackStrategy::peekNextVerse() const
+{
+  int idx = currentIndex();
+  if (idx + 1 >= m_plan.size())
+    return std::nullopt;
+
+  return m_plan.verseAt(idx + 1);
+}
+
+QList<Verse>
+SetPlaybackStrategy::upcomingVerses(int count) const
+{
+  return m_plan.upcoming(currentIndex(), count);
+}
+
+int
+SetPlaybackStrategy::remainingVerses() const
+{
+  return m_plan.size() - currentIndex() - 1;
+}
+
+Verse
+SetPlaybackStrategy::seekIteration(int iteration)
+{
+  if (m_plan.size() == 0)
+    return m_start;
+
+  int iterations = m_plan.size() / m_plan.iterationLength();
+  m_index = std::clamp(iteration, 0, iterations - 1) * m_plan.iterationLength();
+  return m_plan.verseAt(m_index);
 }
 
 bool
@@ -1,6 +1,7 @@
 #ifndef SETPLAYBACKSTRATEGY_H
 #define SETPLAYBACKSTRATEGY_H
 
+#include <player/playbackplan.h>
 #include <player/playbackstrategy.h>
 #include <player/verseplayer.h>
 
@@ -17,14 +18,16 @@ public:
   Verse start() override;
   Verse stop() override;
   std::optional<Verse> nextVerse() override;
+  std::optional<Verse> peekNextVerse() const override;
+  QList<Verse> upcomingVerses(int count) const override;
+  int remainingVerses() const override;
   bool verseInRange(const Verse& v) override;
+  Verse seekIteration(int iteration);
 
 private:
-  int m_repeatCount;
-  int m_verseFrequency;
-  int m_currentIteration;
-  int m_currentRepetition;
-  QuranService* m_quranService;
+  int currentIndex() const;
+  PlaybackPlan m_plan;
+  mutable int m_index;
   const Verse& m_current;
   Verse m_start;
   Verse m_end;
@@ -0,0 +1,149 @@
+/**
+ * @file pcmcache.cpp
+ * @brief Implementation file for PcmCache
+ */
+
+#include "pcmcache.h"
+#include <QDebug>
+#include <QUrl>
+#include <player/recitationpack.h>
+#include <player/versestreamer.h>
+
+PcmCache::PcmCache(QObject* parent, int limitMb)
+  : QObject(parent)
+  , m_cache(std::max(1, limitMb) * 1024)
+{
+  connect(
+    &m_decoder, &QAudioDecoder::bufferReady, this, &PcmCache::bufferReady);
+  connect(&m_decoder, &QAudioDecoder::finished, this, &PcmCache::finished);
+  connect(&m_decoder,
+          qOverload<QAudioDecoder::Error>(&QAudioDecoder::error),
+          this,
+          [this](QAudioDecoder::Error) {
+            qWarning() << "Couldn't decode" << m_decoding
+                       << m_decoder.errorString();
+            QString path = m_decoding;
+            m_decoder.stop();
+            closeDevice();
+            m_decoding.clear();
+            m_data.clear();
+            emit failed(path);
+            decodeNext();
+          });
+}
+
+void
+PcmCache::setFormat(const QAudioFormat& format)
+{
+  if (format == m_format)
+    return;
+
+  m_format = format;
+  clear();
+}
+
+const QAudioFormat&
+PcmCache::format() const
+{
+  return m_format;
+}
+
+QByteArray
+PcmCache::find(const QString& path)
+{
+  const QByteArray* data = m_cache.object(path);
+  data ? m_hits++ : m_misses++;
+  return data ? *data : QByteArray();
+}
+
+void
+PcmCache::request(const QString& path)
+{
+  if (m_cache.contains(path) || m_decoding == path ||
+      m_pending.contains(path))
+    return;
+
+  m_pending.append(path);
+  if (m_decoding.isEmpty())
+    decodeNext();
+}
+
+void
+PcmCache::decodeNext()
+{
+  if (m_pending.isEmpty())
+    return;
+
+  m_decoding = m_pending.takeFirst();
+  m_data.clear();
+  m_decoder.setAudioFormat(m_format);
+  m_device = RecitationPack::openSource(m_decoding, this);
+  if (!m_device)
+    m_device = VerseStreamer::getInstance().openSource(m_decoding, this);
+  if (m_device)
+    m_decoder.setSourceDevice(m_device);
+  else
+    m_decoder.setSource(QUrl::fromLocalFile(m_decoding));
+  m_decoder.start();
+}
+
+void
+PcmCache::bufferReady()
+{
+  QAudioBuffer buffer = m_decoder.read();
+  if (buffer.format() != m_format) {
+    qWarning() << "Decoder output format" << buffer.format()
+               << "doesn't match the output format";
+    return;
+  }
+
+  m_data.append(buffer.constData<char>(), buffer.byteCount());
+}
+
+void
+PcmCache::finished()
+{
+  QString path = m_decoding;
+  m_decoding.clear();
+  closeDevice();
+
+  // a file larger than the whole cache is still served once
+  qint64 cost = m_data.size() / 1024 + 1;
+  if (cost > m_cache.maxCost())
+    qWarning() << "Decoded" << path << "exceeds the PCM cache size";
+
+  QByteArray data = std::move(m_data);
+  m_data = QByteArray();
+  m_cache.insert(path, new QByteArray(data), cost);
+  emit decoded(path, data);
+  decodeNext();
+}
+
+void
+PcmCache::closeDevice()
+{
+  if (!m_device)
+    return;
+
+  m_decoder.setSource(QUrl());
+  m_device->deleteLater();
+  m_device = nullptr;
+}
+
+PcmCache::Stats
+PcmCache::stats() const
+{
+  Stats stats;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.bytes = qint64(m_cache.totalCost()) * 1024;
+  stats.limit = qint64(m_cache.maxCost()) * 1024;
+  stats.entries = m_cache.size();
+  return stats;
+}
+
+void
+PcmCache::clear()
+{
+  m_cache.clear();
+}
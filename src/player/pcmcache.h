@@ -0,0 +1,125 @@
+/**
+ * @file pcmcache.h
+ * @brief Header file for the PcmCache class
+ */
+
+#ifndef PCMCACHE_H
+#define PCMCACHE_H
+
+#include <QAudioDecoder>
+#include <QAudioFormat>
+#include <QByteArray>
+#include <QCache>
+#include <QIODevice>
+#include <QObject>
+#include <QStringList>
+
+/**
+ * @class PcmCache
+ * @brief Decodes verse recitations to PCM once and keeps them in memory.
+ *
+ * Files are decoded one at a time with QAudioDecoder into the format of the
+ * audio output. Decoded files are kept in a least recently used cache bounded
+ * by the total PCM size, so repeated verses are played without opening or
+ * decoding the file again.
+ */
+class PcmCache : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Stats struct holds the cache usage counters.
+   */
+  struct Stats
+  {
+    qint64 hits = 0;   ///< Lookups served from memory.
+    qint64 misses = 0; ///< Lookups that needed a decode.
+    qint64 bytes = 0;  ///< PCM bytes currently held.
+    qint64 limit = 0;  ///< Maximum PCM bytes held.
+    int entries = 0;   ///< Number of cached files.
+  };
+  /**
+   * @brief Constructs a PcmCache object.
+   * @param parent Pointer to the parent QObject.
+   * @param limitMb Maximum size of the cached PCM data in megabytes.
+   */
+  explicit PcmCache(QObject* parent, int limitMb);
+  /**
+   * @brief Sets the format files are decoded to, the cache is cleared if the
+   * format changes.
+   * @param format The QAudioFormat of the audio output.
+   */
+  void setFormat(const QAudioFormat& format);
+  /**
+   * @brief Gets the format of the cached PCM data.
+   * @return The QAudioFormat files are decoded to.
+   */
+  const QAudioFormat& format() const;
+  /**
+   * @brief Looks up the decoded PCM data of a file and counts the hit or
+   * miss.
+   * @param path The absolute path of the audio file.
+   * @return QByteArray sharing the cached PCM data, a null QByteArray if the
+   * file is not decoded.
+   */
+  QByteArray find(const QString& path);
+  /**
+   * @brief Queues the file for decoding, decoded() is emitted once done.
+   * @param path The absolute path of the audio file, a packed verse source,
+   * see RecitationPack, or a verse being streamed, see VerseStreamer.
+   */
+  void request(const QString& path);
+  /**
+   * @brief Gets the cache usage counters.
+   * @return Stats of the cache.
+   */
+  Stats stats() const;
+  /**
+   * @brief Removes all the decoded data.
+   */
+  void clear();
+
+signals:
+  /**
+   * @brief Emitted when a requested file is decoded and cached.
+   * @param path The absolute path of the decoded file.
+   * @param pcm The decoded PCM data.
+   */
+  void decoded(const QString& path, const QByteArray& pcm);
+  /**
+   * @brief Emitted when a requested file could not be decoded.
+   * @param path The absolute path of the file.
+   */
+  void failed(const QString& path);
+
+private:
+  /**
+   * @brief Starts decoding the next queued file.
+   */
+  void decodeNext();
+  /**
+   * @brief Appends the available decoded buffer to the current file data.
+   */
+  void bufferReady();
+  /**
+   * @brief Caches the decoded file and starts the next one.
+   */
+  void finished();
+  /**
+   * @brief Releases the device of the packed verse being decoded.
+   */
+  void closeDevice();
+  QAudioDecoder m_decoder;       ///< Decoder of the current file.
+  QAudioFormat m_format;         ///< Format files are decoded to.
+  QStringList m_pending;         ///< Files waiting to be decoded.
+  QString m_decoding;            ///< File currently decoded.
+  QIODevice* m_device = nullptr; ///< Device of a packed verse being decoded.
+  QByteArray m_data;             ///< Decoded data of the current file.
+  QCache<QString, QByteArray>
+    m_cache; ///< Decoded files by path, the cost is the size in KB.
+  qint64 m_hits = 0;
+  qint64 m_misses = 0;
+};
+
+#endif // PCMCACHE_H
@@ -0,0 +1,353 @@
+/**
+ * @file pcmengine.cpp
+ * @brief Implementation file for PcmEngine
+ */
+
+#include "pcmengine.h"
+#include <QDebug>
+#include <QMediaDevices>
+
+PcmEngine::PcmEngine(QObject* parent, int cacheMb)
+  : QObject(parent)
+  , m_cache(new PcmCache(this, cacheMb))
+  , m_stream(new PcmStream(this))
+{
+  m_clock.setInterval(20);
+  connect(&m_clock, &QTimer::timeout, this, &PcmEngine::updatePosition);
+  connect(m_cache, &PcmCache::decoded, this, &PcmEngine::decoded);
+  connect(m_cache, &PcmCache::failed, this, [this](const QString& path) {
+    if (path == m_source.path && m_status == QMediaPlayer::LoadingMedia)
+      setStatus(QMediaPlayer::InvalidMedia);
+    if (path == m_queued)
+      m_queued.clear();
+  });
+
+  setDevice(QMediaDevices::defaultAudioOutput());
+}
+
+PcmEngine::~PcmEngine()
+{
+  if (m_sink)
+    m_sink->stop();
+  reportStats();
+}
+
+void
+PcmEngine::load(const QString& path)
+{
+  if (m_sink)
+    m_sink->stop();
+  m_clock.stop();
+  m_playWhenLoaded = false;
+  m_queued.clear();
+  m_pending.clear();
+  m_source = { path, path.isEmpty() ? QByteArray() : m_cache->find(path) };
+  m_stream->setCurrent(m_source.pcm);
+  m_position = 0;
+  setState(QMediaPlayer::StoppedState);
+
+  if (path.isEmpty()) {
+    setStatus(QMediaPlayer::NoMedia);
+  } else if (m_source.pcm.isNull()) {
+    setStatus(QMediaPlayer::LoadingMedia);
+    m_cache->request(path);
+  } else {
+    setStatus(QMediaPlayer::LoadedMedia);
+  }
+
+  emit durationChanged(duration());
+  emit positionChanged(0);
+}
+
+void
+PcmEngine::queue(const QString& path)
+{
+  m_queued.clear();
+  QByteArray pcm = path.isEmpty() ? QByteArray() : m_cache->find(path);
+  if (!path.isEmpty() && pcm.isNull()) {
+    // nothing is queued until the decode is done
+    m_queued = path;
+    queuePcm(QString(), QByteArray());
+    m_cache->request(path);
+    return;
+  }
+
+  queuePcm(path, pcm);
+}
+
+void
+PcmEngine::queuePcm(const QString& path, const QByteArray& pcm)
+{
+  if (m_stream->setNext(pcm) && !m_pending.isEmpty())
+    m_pending.removeLast();
+  if (!pcm.isNull())
+    m_pending.append({ path, pcm });
+}
+
+void
+PcmEngine::decoded(const QString& path, const QByteArray& pcm)
+{
+  if (path == m_source.path && m_status == QMediaPlayer::LoadingMedia) {
+    m_source.pcm = pcm;
+    m_stream->setCurrent(pcm);
+    setStatus(QMediaPlayer::LoadedMedia);
+    emit durationChanged(duration());
+    if (m_playWhenLoaded)
+      play();
+  } else if (path == m_queued) {
+    m_queued.clear();
+    queuePcm(path, pcm);
+  }
+}
+
+const QString&
+PcmEngine::source() const
+{
+  return m_source.path;
+}
+
+QMediaPlayer::PlaybackState
+PcmEngine::playbackState() const
+{
+  return m_state;
+}
+
+QMediaPlayer::MediaStatus
+PcmEngine::mediaStatus() const
+{
+  return m_status;
+}
+
+qint64
+PcmEngine::duration() const
+{
+  return m_cache->format().durationForBytes(m_source.pcm.size()) / 1000;
+}
+
+qint64
+PcmEngine::position() const
+{
+  return m_position;
+}
+
+PcmCache*
+PcmEngine::cache() const
+{
+  return m_cache;
+}
+
+void
+PcmEngine::reportStats() const
+{
+  PcmCache::Stats stats = m_cache->stats();
+  qint64 lookups = stats.hits + stats.misses;
+  qInfo().noquote() << QString("PCM cache: %0 files, %1 of %2 MB, %3 hits, "
+                               "%4 misses (%5% hit rate)")
+                         .arg(stats.entries)
+                         .arg(stats.bytes / 1048576.0, 0, 'f', 1)
+                         .arg(stats.limit / 1048576)
+                         .arg(stats.hits)
+                         .arg(stats.misses)
+                         .arg(lookups ? 100.0 * stats.hits / lookups : 0.0,
+                              0,
+                              'f',
+                              1);
+}
+
+void
+PcmEngine::play()
+{
+  if (m_status == QMediaPlayer::LoadingMedia) {
+    m_playWhenLoaded = true;
+    setState(QMediaPlayer::PlayingState);
+    return;
+  }
+
+  if (m_source.pcm.isNull())
+    return;
+
+  if (m_status == QMediaPlayer::EndOfMedia) {
+    m_stream->setCurrent(m_source.pcm);
+    setStatus(QMediaPlayer::LoadedMedia);
+  }
+
+  if (m_sink->state() == QAudio::SuspendedState)
+    m_sink->resume();
+  else
+    startSink();
+
+  m_playWhenLoaded = false;
+  m_clock.start();
+  setState(QMediaPlayer::PlayingState);
+}
+
+void
+PcmEngine::pause()
+{
+  m_playWhenLoaded = false;
+  if (m_sink->state() == QAudio::ActiveState ||
+      m_sink->state() == QAudio::IdleState) {
+    updatePosition();
+    m_sink->suspend();
+  }
+
+  m_clock.stop();
+  setState(QMediaPlayer::PausedState);
+}
+
+void
+PcmEngine::stop()
+{
+  m_sink->stop();
+  m_clock.stop();
+  m_playWhenLoaded = false;
+
+  // anything read ahead is dropped, the current source stays loaded
+  m_queued.clear();
+  m_pending.clear();
+  m_stream->setCurrent(m_source.pcm);
+  m_position = 0;
+  emit positionChanged(0);
+  setState(QMediaPlayer::StoppedState);
+}
+
+void
+PcmEngine::setPosition(qint64 position)
+{
+  if (m_source.pcm.isNull())
+    return;
+
+  const QAudioFormat& format = m_cache->format();
+  qint64 offset = format.bytesForDuration(position * 1000);
+  offset -= offset % std::max(1, format.bytesPerFrame());
+
+  // the queued sources read ahead are dropped, only the next one is kept
+  m_stream->setCurrent(m_source.pcm);
+  if (!m_pending.isEmpty()) {
+    m_pending.resize(1);
+    m_stream->setNext(m_pending.first().pcm);
+  }
+  m_stream->restart(offset);
+
+  if (m_state == QMediaPlayer::PlayingState)
+    startSink();
+  else
+    m_sink->stop();
+
+  m_position = format.durationForBytes(m_stream->offset()) / 1000;
+  emit positionChanged(m_position);
+}
+
+void
+PcmEngine::setVolume(qreal volume)
+{
+  m_volume = volume;
+  if (m_sink)
+    m_sink->setVolume(volume);
+}
+
+void
+PcmEngine::setDevice(const QAudioDevice& device)
+{
+  bool playing = m_state == QMediaPlayer::PlayingState;
+  if (m_sink) {
+    m_sink->stop();
+    delete m_sink;
+  }
+
+  m_device = device;
+  QAudioFormat format = device.preferredFormat();
+  m_sink = new QAudioSink(device, format, this);
+  m_sink->setVolume(m_volume);
+  connect(
+    m_sink, &QAudioSink::stateChanged, this, &PcmEngine::sinkStateChanged);
+
+  if (format == m_cache->format()) {
+    if (playing)
+      startSink();
+    return;
+  }
+
+  // the cached data is decoded for the previous device
+  m_cache->setFormat(format);
+  if (!m_source.path.isEmpty()) {
+    load(m_source.path);
+    if (playing)
+      play();
+  }
+}
+
+void
+PcmEngine::startSink()
+{
+  qint64 offset = m_stream->offset();
+  m_sink->stop();
+  m_stream->restart(offset);
+  m_segmentStart = -offset;
+  m_sink->start(m_stream);
+}
+
+void
+PcmEngine::updatePosition()
+{
+  const QAudioFormat& format = m_cache->format();
+  qint64 played = format.bytesForDuration(m_sink->processedUSecs());
+  advance(played);
+  m_position = format.durationForBytes(played - m_segmentStart) / 1000;
+  emit positionChanged(m_position);
+}
+
+void
+PcmEngine::advance(qint64 played)
+{
+  qint64 at;
+  while ((at = m_stream->takeSwitch(played)) != -1) {
+    m_segmentStart = at;
+    m_source = m_pending.isEmpty() ? Source() : m_pending.takeFirst();
+    emit durationChanged(duration());
+    emit advanced(m_source.path);
+  }
+}
+
+void
+PcmEngine::sinkStateChanged(QAudio::State state)
+{
+  if (state == QAudio::StoppedState && m_sink->error() != QAudio::NoError) {
+    qWarning() << "Audio sink stopped with error" << m_sink->error();
+    return;
+  }
+
+  // the sink runs dry at the end of the last source, or while the queued
+  // source is still decoding
+  if (state != QAudio::IdleState || m_state != QMediaPlayer::PlayingState)
+    return;
+
+  updatePosition();
+  if (!m_stream->drained() || !m_queued.isEmpty())
+    return;
+
+  m_sink->stop();
+  m_clock.stop();
+  setState(QMediaPlayer::StoppedState);
+  setStatus(QMediaPlayer::EndOfMedia);
+}
+
+void
+PcmEngine::setState(QMediaPlayer::PlaybackState state)
+{
+  if (state == m_state)
+    return;
+
+  m_state = state;
+  emit playbackStateChanged(state);
+}
+
+void
+PcmEngine::setStatus(QMediaPlayer::MediaStatus status)
+{
+  if (status == m_status)
+    return;
+
+  m_status = status;
+  emit mediaStatusChanged(status);
+}
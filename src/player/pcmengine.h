@@ -0,0 +1,179 @@
+/**
+ * @file pcmengine.h
+ * @brief Header file for the PcmEngine class
+ */
+
+#ifndef PCMENGINE_H
+#define PCMENGINE_H
+
+#include "pcmcache.h"
+#include "pcmstream.h"
+#include <QAudioDevice>
+#include <QAudioSink>
+#include <QMediaPlayer>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+/**
+ * @class PcmEngine
+ * @brief Low latency playback of decoded verses through QAudioSink.
+ *
+ * Sources are decoded once into the PcmCache and played from memory through
+ * a PcmStream, a queued source starts on the sample following the end of the
+ * current one. Repeating a verse or a range of cached verses never opens or
+ * decodes a file again. The playback state, media status, position and
+ * duration are reported with the QMediaPlayer enums and signal names, and
+ * advanced() is emitted when a queued source is heard.
+ */
+class PcmEngine : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Constructs a PcmEngine object.
+   * @param parent Pointer to the parent QObject.
+   * @param cacheMb Maximum size of the PCM cache in megabytes.
+   */
+  explicit PcmEngine(QObject* parent, int cacheMb);
+  ~PcmEngine();
+  /**
+   * @brief Loads the source played next, playback is stopped.
+   * @param path The absolute path of the audio file, empty to unload.
+   */
+  void load(const QString& path);
+  /**
+   * @brief Queues the source played right after the current one.
+   * @param path The absolute path of the audio file, empty to clear the
+   * queue.
+   */
+  void queue(const QString& path);
+  /**
+   * @brief Gets the source currently loaded.
+   * @return QString of the absolute path of the audio file.
+   */
+  const QString& source() const;
+  /**
+   * @brief Gets the playback state.
+   * @return QMediaPlayer::PlaybackState of the engine.
+   */
+  QMediaPlayer::PlaybackState playbackState() const;
+  /**
+   * @brief Gets the media status.
+   * @return QMediaPlayer::MediaStatus of the current source.
+   */
+  QMediaPlayer::MediaStatus mediaStatus() const;
+  /**
+   * @brief Gets the duration of the current source.
+   * @return Duration in milliseconds.
+   */
+  qint64 duration() const;
+  /**
+   * @brief Gets the playback position in the current source.
+   * @return Position in milliseconds.
+   */
+  qint64 position() const;
+  /**
+   * @brief Gets the PCM cache used by the engine.
+   * @return Pointer to the PcmCache.
+   */
+  PcmCache* cache() const;
+  /**
+   * @brief Logs the PCM cache memory use and hit rate.
+   */
+  void reportStats() const;
+
+public slots:
+  void play();
+  void pause();
+  void stop();
+  /**
+   * @brief Seeks the current source.
+   * @param position Position in milliseconds.
+   */
+  void setPosition(qint64 position);
+  /**
+   * @brief Sets the volume of the audio sink.
+   * @param volume The volume level (0.0 to 1.0).
+   */
+  void setVolume(qreal volume);
+  /**
+   * @brief Plays through the given device, sources are decoded again if the
+   * device format differs.
+   * @param device The QAudioDevice to use for playback.
+   */
+  void setDevice(const QAudioDevice& device);
+
+signals:
+  void positionChanged(qint64 position);
+  void durationChanged(qint64 duration);
+  void playbackStateChanged(QMediaPlayer::PlaybackState state);
+  void mediaStatusChanged(QMediaPlayer::MediaStatus status);
+  /**
+   * @brief Emitted when the queued source starts being heard.
+   * @param path The absolute path of the new current source.
+   */
+  void advanced(const QString& path);
+
+private:
+  /**
+   * @brief Updates the position from the sink clock and reports the queued
+   * sources heard since the last update.
+   */
+  void updatePosition();
+  /**
+   * @brief Handles the audio sink state, reports the end of media once all
+   * the sources are played.
+   * @param state The new QAudio::State of the sink.
+   */
+  void sinkStateChanged(QAudio::State state);
+  /**
+   * @brief Uses a newly decoded file for the current or queued source.
+   * @param path The absolute path of the decoded file.
+   * @param pcm The decoded PCM data.
+   */
+  void decoded(const QString& path, const QByteArray& pcm);
+  /**
+   * @brief Queues the PCM data of a source in the stream.
+   * @param path The absolute path of the source.
+   * @param pcm The PCM data, a null QByteArray to clear the queue.
+   */
+  void queuePcm(const QString& path, const QByteArray& pcm);
+  /**
+   * @brief Makes the queued sources the sink switched to before the given
+   * sink timeline byte current.
+   * @param played Number of bytes played by the sink since it started.
+   */
+  void advance(qint64 played);
+  /**
+   * @brief Starts pulling from the stream at its current offset.
+   */
+  void startSink();
+  void setState(QMediaPlayer::PlaybackState state);
+  void setStatus(QMediaPlayer::MediaStatus status);
+  PcmCache* m_cache;
+  PcmStream* m_stream;
+  QPointer<QAudioSink> m_sink;
+  QAudioDevice m_device;
+  qreal m_volume = 1.0;
+  QTimer m_clock; ///< Polls the sink position while playing.
+  /**
+   * @brief Source struct holds a source and its PCM data.
+   */
+  struct Source
+  {
+    QString path;
+    QByteArray pcm;
+  };
+  Source m_source;        ///< Current source.
+  QString m_queued;       ///< Queued source waiting for its decode.
+  QList<Source> m_pending; ///< Queued sources in the stream, in order.
+  qint64 m_segmentStart = 0; ///< Sink timeline byte of the current source.
+  qint64 m_position = 0;     ///< Position in the current source in ms.
+  bool m_playWhenLoaded = false;
+  QMediaPlayer::PlaybackState m_state = QMediaPlayer::StoppedState;
+  QMediaPlayer::MediaStatus m_status = QMediaPlayer::NoMedia;
+};
+
+#endif // PCMENGINE_H
@@ -0,0 +1,116 @@
+/**
+ * @file pcmstream.cpp
+ * @brief Implementation file for PcmStream
+ */
+
+#include "pcmstream.h"
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+
+PcmStream::PcmStream(QObject* parent)
+  : QIODevice(parent)
+{
+  open(QIODevice::ReadOnly);
+}
+
+void
+PcmStream::setCurrent(const QByteArray& pcm)
+{
+  QMutexLocker locker(&m_mutex);
+  m_current = pcm;
+  m_next = QByteArray();
+  m_offset = 0;
+  m_read = 0;
+  m_switches.clear();
+}
+
+bool
+PcmStream::setNext(const QByteArray& pcm)
+{
+  QMutexLocker locker(&m_mutex);
+  bool replaced = !m_next.isNull();
+  m_next = pcm;
+  return replaced;
+}
+
+void
+PcmStream::restart(qint64 offset)
+{
+  QMutexLocker locker(&m_mutex);
+  m_offset = std::clamp<qint64>(offset, 0, m_current.size());
+  m_read = 0;
+  m_switches.clear();
+}
+
+qint64
+PcmStream::offset() const
+{
+  QMutexLocker locker(&m_mutex);
+  return m_offset;
+}
+
+qint64
+PcmStream::takeSwitch(qint64 played)
+{
+  QMutexLocker locker(&m_mutex);
+  if (m_switches.isEmpty() || m_switches.first() > played)
+    return -1;
+
+  return m_switches.takeFirst();
+}
+
+bool
+PcmStream::drained() const
+{
+  QMutexLocker locker(&m_mutex);
+  return m_offset >= m_current.size() && m_next.isNull();
+}
+
+bool
+PcmStream::isSequential() const
+{
+  return true;
+}
+
+qint64
+PcmStream::bytesAvailable() const
+{
+  QMutexLocker locker(&m_mutex);
+  return m_current.size() - m_offset + m_next.size() +
+         QIODevice::bytesAvailable();
+}
+
+qint64
+PcmStream::readData(char* data, qint64 maxSize)
+{
+  QMutexLocker locker(&m_mutex);
+  qint64 copied = 0;
+  while (copied < maxSize) {
+    if (m_offset >= m_current.size()) {
+      if (m_next.isNull())
+        break;
+
+      // switch within the same read, the sink never sees a gap
+      m_current = m_next;
+      m_next = QByteArray();
+      m_offset = 0;
+      m_switches.append(m_read + copied);
+      continue;
+    }
+
+    qint64 n = std::min(maxSize - copied, m_current.size() - m_offset);
+    std::memcpy(data + copied, m_current.constData() + m_offset, n);
+    m_offset += n;
+    copied += n;
+  }
+
+  m_read += copied;
+  return copied;
+}
+
+qint64
+PcmStream::writeData(const char*, qint64)
+{
+  return -1;
+}
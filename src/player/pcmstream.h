@@ -0,0 +1,84 @@
+/**
+ * @file pcmstream.h
+ * @brief Header file for the PcmStream class
+ */
+
+#ifndef PCMSTREAM_H
+#define PCMSTREAM_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QList>
+#include <QMutex>
+
+/**
+ * @class PcmStream
+ * @brief Sequential device the audio sink pulls decoded verses from.
+ *
+ * The stream reads the current PCM buffer and continues with the queued one in
+ * the same read, so consecutive and repeated verses play back to back without
+ * a single missing sample. The sink position of every switch is recorded so
+ * the switch can be reported when it is actually heard. The buffers are shared
+ * with the PcmCache and never copied. The sink may read from its own thread,
+ * all the state is guarded by a mutex.
+ */
+class PcmStream : public QIODevice
+{
+public:
+  /**
+   * @brief Constructs a PcmStream object.
+   * @param parent Pointer to the parent QObject.
+   */
+  explicit PcmStream(QObject* parent);
+  /**
+   * @brief Replaces the current buffer and drops the queued one.
+   * @param pcm The PCM data of the current source.
+   */
+  void setCurrent(const QByteArray& pcm);
+  /**
+   * @brief Queues the buffer read after the current one.
+   * @param pcm The PCM data of the next source, a null QByteArray to clear
+   * the queue.
+   * @return Boolean indicating whether a queued buffer not yet reached was
+   * replaced.
+   */
+  bool setNext(const QByteArray& pcm);
+  /**
+   * @brief Moves the read position in the current buffer and restarts the
+   * sink timeline at the new position.
+   * @param offset Byte offset in the current buffer.
+   */
+  void restart(qint64 offset);
+  /**
+   * @brief Gets the read position in the current buffer.
+   * @return Byte offset in the current buffer.
+   */
+  qint64 offset() const;
+  /**
+   * @brief Takes the first recorded switch to a queued buffer.
+   * @param played Number of bytes played by the sink since the last restart.
+   * @return Sink timeline byte of the switch, -1 if no switch was played yet.
+   */
+  qint64 takeSwitch(qint64 played);
+  /**
+   * @brief Checks whether all the buffers are read.
+   * @return Boolean indicating whether nothing is left to read.
+   */
+  bool drained() const;
+  bool isSequential() const override;
+  qint64 bytesAvailable() const override;
+
+protected:
+  qint64 readData(char* data, qint64 maxSize) override;
+  qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+  mutable QMutex m_mutex;
+  QByteArray m_current; ///< Buffer currently read.
+  QByteArray m_next;    ///< Buffer read after m_current.
+  qint64 m_offset = 0;  ///< Read position in m_current.
+  qint64 m_read = 0;    ///< Bytes read since the last restart.
+  QList<qint64> m_switches; ///< Sink timeline bytes of the buffer switches.
+};
+
+#endif // PCMSTREAM_H
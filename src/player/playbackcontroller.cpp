@@ -1,5 +1,6 @@
 #include "playbackcontroller.h"
 #include <player/impl/continuousplaybackstrategy.h>
+#include <player/transitionmonitor.h>
 
 PlaybackController::PlaybackController(QObject* parent,
                                        QPointer<VersePlayer> player)
@@ -11,9 +12,17 @@ PlaybackController::PlaybackController(QObject* parent,
 {
   resetStrategy();
   connect(m_player,
-          &QMediaPlayer::mediaStatusChanged,
+          &VersePlayer::mediaStatusChanged,
           this,
           &PlaybackController::mediaStatusChanged);
+  connect(m_player,
+          &VersePlayer::playbackStateChanged,
+          this,
+          &PlaybackController::playbackStateChanged);
+  connect(m_player, &VersePlayer::positionChanged, this, [](qint64 position) {
+    if (position > 0)
+      TransitionMonitor::getInstance().mark(TransitionMonitor::FirstPosition);
+  });
   m_navigator.addObserver(this);
 }
 
@@ -27,6 +36,8 @@ void
 PlaybackController::setStrategy(std::shared_ptr<PlaybackStrategy> newStrategy)
 {
   m_strategy = newStrategy;
+  if (m_player->isOn())
+    preloadNext();
 }
 
 void
@@ -41,6 +52,7 @@ void
 PlaybackController::next()
 {
   std::optional<Verse> nextVerse = m_strategy->nextVerse();
+  TransitionMonitor::getInstance().mark(TransitionMonitor::Decision);
   if (nextVerse.has_value()) {
     m_navigator.navigateToVerse(nextVerse.value());
   } else {
@@ -53,28 +65,62 @@ void
 PlaybackController::stop()
 {
   m_player->stop();
+  m_player->cancelStreams();
+  m_player->reportStats();
+  TransitionMonitor::getInstance().logReport();
   Verse stopVerse = m_strategy->stop();
   m_navigator.navigateToVerse(stopVerse);
+  TransitionMonitor::getInstance().cancel();
 }
 
 void
 PlaybackController::mediaStatusChanged(QMediaPlayer::MediaStatus status)
 {
-  if (status == QMediaPlayer::EndOfMedia)
+  TransitionMonitor& monitor = TransitionMonitor::getInstance();
+  if (status == QMediaPlayer::EndOfMedia) {
+    monitor.mark(TransitionMonitor::EndOfMedia);
     next();
+  } else if (status == QMediaPlayer::LoadedMedia ||
+             status == QMediaPlayer::BufferedMedia) {
+    monitor.mark(TransitionMonitor::MediaLoaded);
+  }
+}
+
+void
+PlaybackController::playbackStateChanged(QMediaPlayer::PlaybackState state)
+{
+  // a handed over verse starts playing before the strategy advances, the next
+  // verse is preloaded once the handover is taken
+  if (state == QMediaPlayer::PlayingState && !m_player->handoverPending())
+    preloadNext();
+}
+
+void
+PlaybackController::preloadNext()
+{
+  m_player->preload(m_strategy->peekNextVerse());
+  m_player->prefetch(m_strategy->upcomingVerses(s_prefetchCount));
 }
 
 void
 PlaybackController::activeVerseChanged()
 {
   bool keepPlaying = m_player->isOn();
-  m_player->stop();
+  bool handedOver = m_player->takeHandover(m_current);
+  if (!handedOver)
+    m_player->stop();
 
   if (!m_strategy->verseInRange(m_current)) {
     emit verseOutOfPlaybackRange();
     resetStrategy();
   }
 
+  // the preloaded verse is already playing after a gapless handover
+  if (handedOver && keepPlaying) {
+    preloadNext();
+    return;
+  }
+
   m_player->loadActiveVerse();
   if (keepPlaying)
     m_player->play();
@@ -83,8 +83,22 @@ private slots:
    * @param status The new media status of the player.
    */
   void mediaStatusChanged(QMediaPlayer::MediaStatus status);
+  /**
+   * @brief Preloads the next verse of the strategy once playback starts.
+   * @param state The new playback state of the player.
+   */
+  void playbackStateChanged(QMediaPlayer::PlaybackState state);
 
 private:
+  /**
+   * @brief Preloads the next verse of the strategy in the player and
+   * prefetches the ones after it.
+   */
+  void preloadNext();
+  /**
+   * @brief Number of upcoming verses prefetched while playing.
+   */
+  static const int s_prefetchCount = 4;
   Verse& m_current; ///< Reference to the current verse being played.
   Navigator&
     m_navigator; ///< Reference to the Navigator for managing verse navigation.
@@ -0,0 +1,157 @@
+/**
+ * @file playbackplan.cpp
+ * @brief Implementation file for PlaybackPlan
+ */
+
+#include "playbackplan.h"
+#include <algorithm>
+#include <service/servicefactory.h>
+
+QList<int> PlaybackPlan::s_firstIds;
+QList<int> PlaybackPlan::s_pages;
+
+void
+PlaybackPlan::loadTables()
+{
+  if (!s_firstIds.isEmpty())
+    return;
+
+  s_firstIds.reserve(115);
+  int id = 1;
+  for (int count : Verse::verseCount) {
+    s_firstIds.append(id);
+    id += count;
+  }
+  s_firstIds.append(id);
+
+  s_pages = ServiceFactory::quranService()->versePages();
+}
+
+int
+PlaybackPlan::surahOf(int id)
+{
+  auto it = std::upper_bound(s_firstIds.cbegin(), s_firstIds.cend(), id);
+  return int(it - s_firstIds.cbegin());
+}
+
+PlaybackPlan
+PlaybackPlan::continuous()
+{
+  return range(Verse(1, 1, 1), Verse(604, 114, 6), 1, 1);
+}
+
+PlaybackPlan
+PlaybackPlan::range(const Verse& start,
+                    const Verse& end,
+                    int repeatCount,
+                    int verseFrequency)
+{
+  loadTables();
+
+  // a single iteration without repetitions, basmallah is played before the
+  // first verse of every surah except Al-Fatihah & At-Tawbah, and at the
+  // start of the range only if the range starts with it
+  QList<QPair<int, bool>> sequence;
+  int first =
+    s_firstIds.at(start.surah() - 1) + std::max(1, start.number()) - 1;
+  int last = s_firstIds.at(end.surah() - 1) + std::max(1, end.number()) - 1;
+  for (int id = first; id <= last; id++) {
+    int surah = surahOf(id);
+    bool opensSurah = id == s_firstIds.at(surah - 1);
+    if (opensSurah && surah != 1 && surah != 9 &&
+        (id != first || start.number() == 0))
+      sequence.append({ id, true });
+    if (id == last && end.number() == 0)
+      break;
+    sequence.append({ id, false });
+  }
+
+  PlaybackPlan plan;
+  verseFrequency = std::max(1, verseFrequency);
+  plan.m_firstId = first;
+  plan.m_startBasmallah = start.number() == 0 && start.surah() != 1 &&
+                          start.surah() != 9;
+  plan.m_verseFrequency = verseFrequency;
+  plan.m_iterationLength = sequence.size() * verseFrequency;
+  plan.m_steps.reserve(plan.m_iterationLength * std::max(1, repeatCount));
+  for (int i = 0; i < std::max(1, repeatCount); i++) {
+    for (const QPair<int, bool>& entry : std::as_const(sequence)) {
+      for (int r = 0; r < verseFrequency; r++)
+        plan.m_steps.append(
+          { quint16(entry.first), quint8(std::min(r, 255)), entry.second });
+    }
+  }
+
+  return plan;
+}
+
+int
+PlaybackPlan::size() const
+{
+  return m_steps.size();
+}
+
+int
+PlaybackPlan::iterationLength() const
+{
+  return m_iterationLength;
+}
+
+const PlaybackPlan::Step&
+PlaybackPlan::at(int index) const
+{
+  return m_steps.at(index);
+}
+
+Verse
+PlaybackPlan::verseAt(int index) const
+{
+  const Step& step = m_steps.at(index);
+  int surah = surahOf(step.id);
+  int number = step.basmallah ? 0 : step.id - s_firstIds.at(surah - 1) + 1;
+  return Verse(s_pages.value(step.id - 1, 1), surah, number);
+}
+
+int
+PlaybackPlan::indexOf(const Verse& v, int from) const
+{
+  if (m_steps.isEmpty() || v.surah() < 1 || v.surah() > 114)
+    return -1;
+
+  int id = s_firstIds.at(v.surah() - 1) + std::max(1, v.number()) - 1;
+  bool basmallah = v.number() == 0;
+  if (id < m_firstId)
+    return -1;
+
+  // the verses before it in the range, plus a basmallah for every surah opened
+  // up to it, At-Tawbah has none
+  int surah = surahOf(id);
+  int firstSurah = surahOf(m_firstId);
+  int opened = surah - firstSurah - (firstSurah < 9 && surah >= 9);
+  int position = id - m_firstId + opened + m_startBasmallah - basmallah;
+  int index = position * m_verseFrequency;
+  if (index < 0 || index >= m_iterationLength || m_steps.at(index).id != id ||
+      m_steps.at(index).basmallah != basmallah)
+    return -1;
+
+  // the same step in the iteration of from, or the next one if from is past
+  // the repetitions of the verse
+  from = std::max(0, from);
+  index += from - from % m_iterationLength;
+  if (index + m_verseFrequency <= from)
+    index += m_iterationLength;
+  index = std::max(index, from);
+
+  return index < m_steps.size() ? index : -1;
+}
+
+QList<Verse>
+PlaybackPlan::upcoming(int index, int count) const
+{
+  QList<Verse> verses;
+  int last = std::min<int>(m_steps.size() - 1, index + count);
+  for (int i = index + 1; i <= last; i++)
+    verses.append(verseAt(i));
+
+  return verses;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file playbackplan.h
+ * @brief Header file for the PlaybackPlan class
+ */
+
+#ifndef PLAYBACKPLAN_H
+#define PLAYBACKPLAN_H
+
+#include <QList>
+#include <types/verse.h>
+
+/**
+ * @class PlaybackPlan
+ * @brief The whole schedule of a playback strategy compiled up front.
+ *
+ * A plan is a compact array of steps, one for every verse played including
+ * the basmallah before the first verse of a surah and every repetition of a
+ * verse. Steps are resolved to verses from static tables of the verse ids and
+ * pages, so stepping through a plan never queries the database. Looking ahead,
+ * counting the remaining steps and jumping to a repetition are index
+ * arithmetic.
+ */
+class PlaybackPlan
+{
+public:
+  /**
+   * @brief Step struct represents a single played verse.
+   */
+  struct Step
+  {
+    quint16 id;     ///< Verse id (1-6236), the first verse for a basmallah.
+    quint8 repeat;  ///< Repetition index of the verse.
+    bool basmallah; ///< Indicates the step plays the basmallah of the surah.
+  };
+  /**
+   * @brief Compiles the plan of the whole Quran, each verse played once.
+   * @return PlaybackPlan from Al-Fatihah to An-Nas.
+   */
+  static PlaybackPlan continuous();
+  /**
+   * @brief Compiles the plan of a repeated range of verses.
+   * @param start The first verse, a basmallah if its number is 0.
+   * @param end The last verse.
+   * @param repeatCount Number of times the whole range is played.
+   * @param verseFrequency Number of times each verse is played in a row.
+   * @return PlaybackPlan of the range.
+   */
+  static PlaybackPlan range(const Verse& start,
+                           const Verse& end,
+                           int repeatCount,
+                           int verseFrequency);
+  /**
+   * @brief Gets the number of steps.
+   * @return Total number of played verses.
+   */
+  int size() const;
+  /**
+   * @brief Gets the number of steps in a single repetition of the range.
+   * @return Number of steps of the first iteration.
+   */
+  int iterationLength() const;
+  /**
+   * @brief Gets the step at the given index.
+   * @param index Step index.
+   * @return Reference to the Step.
+   */
+  const Step& at(int index) const;
+  /**
+   * @brief Resolves the step at the given index to a verse.
+   * @param index Step index.
+   * @return Verse played at the step, with its page.
+   */
+  Verse verseAt(int index) const;
+  /**
+   * @brief Finds the first step playing the given verse, the index is computed
+   * from the verse id without searching the steps.
+   * @param v The verse to find.
+   * @param from Index to start searching from.
+   * @return Index of the step, -1 if the verse is not in the plan after from.
+   */
+  int indexOf(const Verse& v, int from = 0) const;
+  /**
+   * @brief Resolves the steps following the given index to verses.
+   * @param index Current step index.
+   * @param count Maximum number of verses to return.
+   * @return QList of the upcoming verses in play order.
+   */
+  QList<Verse> upcoming(int index, int count) const;
+
+private:
+  /**
+   * @brief Fills the static verse id & page tables on first use.
+   */
+  static void loadTables();
+  /**
+   * @brief Gets the surah of a verse id.
+   * @param id Verse id (1-6236).
+   * @return Surah number (1-114).
+   */
+  static int surahOf(int id);
+  /**
+   * @brief id of the first verse of each surah, index 114 is one past the
+   * last verse.
+   */
+  static QList<int> s_firstIds;
+  /**
+   * @brief page of each verse indexed by the verse id - 1.
+   */
+  static QList<int> s_pages;
+  QList<Step> m_steps;
+  int m_iterationLength = 0;
+  /**
+   * @brief id of the first verse in the range.
+   */
+  int m_firstId = 1;
+  /**
+   * @brief Indicates the range starts with a basmallah.
+   */
+  bool m_startBasmallah = false;
+  /**
+   * @brief Number of times each verse is played in a row.
+   */
+  int m_verseFrequency = 1;
+};
+
+#endif // PLAYBACKPLAN_H
@@ -1,6 +1,8 @@
 #ifndef PLAYBACKSTRATEGY_H
 #define PLAYBACKSTRATEGY_H
 
+#include <QList>
+#include <optional>
 #include <types/verse.h>
 
 /**
@@ -31,6 +33,26 @@ public:
    * no next verse, the result is an empty optional.
    */
   virtual std::optional<Verse> nextVerse() = 0;
+  /**
+   * @brief Gets the verse the next call to nextVerse() returns without
+   * advancing the playback sequence, used to preload the next verse.
+   * @return An optional Verse object representing the next verse. If there is
+   * no next verse, the result is an empty optional.
+   */
+  virtual std::optional<Verse> peekNextVerse() const = 0;
+  /**
+   * @brief Gets the verses following the current one in the playback
+   * sequence, used to prefetch the next files.
+   * @param count Maximum number of verses to return.
+   * @return QList of the upcoming verses in play order.
+   */
+  virtual QList<Verse> upcomingVerses(int count) const = 0;
+  /**
+   * @brief Gets the number of verses left in the playback sequence after the
+   * current one.
+   * @return Number of remaining verses, including repetitions.
+   */
+  virtual int remainingVerses() const = 0;
   /**
    * @brief Checks if a given verse is within the playback range.
    * @param verse The Verse object to be checked.
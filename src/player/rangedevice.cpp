@@ -0,0 +1,79 @@
+/**
+ * @file rangedevice.cpp
+ * @brief Implementation file for RangeDevice
+ */
+
+#include "rangedevice.h"
+#include <QDebug>
+
+RangeDevice::RangeDevice(const QString& path,
+                         qint64 offset,
+                         qint64 size,
+                         QObject* parent)
+  : QIODevice(parent)
+  , m_file(path)
+  , m_offset(offset)
+  , m_size(size)
+{
+}
+
+bool
+RangeDevice::open(OpenMode mode)
+{
+  if (mode != QIODevice::ReadOnly || !m_file.open(QIODevice::ReadOnly))
+    return false;
+
+  if (m_file.size() < m_offset + m_size || !m_file.seek(m_offset)) {
+    qWarning() << "Range exceeds the size of" << m_file.fileName();
+    m_file.close();
+    return false;
+  }
+
+  return QIODevice::open(mode);
+}
+
+void
+RangeDevice::close()
+{
+  m_file.close();
+  QIODevice::close();
+}
+
+bool
+RangeDevice::isSequential() const
+{
+  return false;
+}
+
+qint64
+RangeDevice::size() const
+{
+  return m_size;
+}
+
+bool
+RangeDevice::seek(qint64 pos)
+{
+  if (pos < 0 || pos > m_size || !m_file.seek(m_offset + pos))
+    return false;
+
+  return QIODevice::seek(pos);
+}
+
+qint64
+RangeDevice::readData(char* data, qint64 maxSize)
+{
+  qint64 left = m_size - (m_file.pos() - m_offset);
+  if (left <= 0)
+    return 0;
+
+  return m_file.read(data, std::min(maxSize, left));
+}
+
+qint64
+RangeDevice::writeData(const char* data, qint64 maxSize)
+{
+  Q_UNUSED(data);
+  Q_UNUSED(maxSize);
+  return -1;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file rangedevice.h
+ * @brief Header file for the RangeDevice class
+ */
+
+#ifndef RANGEDEVICE_H
+#define RANGEDEVICE_H
+
+#include <QFile>
+#include <QIODevice>
+
+/**
+ * @class RangeDevice
+ * @brief Read-only device exposing a byte range of a file as a whole file.
+ *
+ * Used to play a single verse out of a RecitationPack, the media backend sees
+ * a seekable device that starts at the first byte of the verse and ends at its
+ * last byte.
+ */
+class RangeDevice : public QIODevice
+{
+public:
+  /**
+   * @brief Constructs a RangeDevice object.
+   * @param path The absolute path of the file.
+   * @param offset The offset of the first byte of the range.
+   * @param size The number of bytes in the range.
+   * @param parent Pointer to the parent QObject.
+   */
+  RangeDevice(const QString& path,
+              qint64 offset,
+              qint64 size,
+              QObject* parent = nullptr);
+  /**
+   * @brief Opens the underlying file, only QIODevice::ReadOnly is supported.
+   * @param mode The QIODevice::OpenMode to open the device in.
+   * @return Boolean indicating whether the file was opened.
+   */
+  bool open(OpenMode mode) override;
+  void close() override;
+  bool isSequential() const override;
+  qint64 size() const override;
+  bool seek(qint64 pos) override;
+
+protected:
+  qint64 readData(char* data, qint64 maxSize) override;
+  qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+  QFile m_file;          ///< File containing the range.
+  const qint64 m_offset; ///< Offset of the range in the file.
+  const qint64 m_size;   ///< Size of the range.
+};
+
+#endif // RANGEDEVICE_H
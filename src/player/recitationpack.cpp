@@ -0,0 +1,190 @@
+/**
+ * @file recitationpack.cpp
+ * @brief Implementation file for RecitationPack
+ */
+
+#include "recitationpack.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <player/rangedevice.h>
+#include <types/verse.h>
+
+QString
+RecitationPack::fileName(int surah)
+{
+  return QString::number(surah).rightJustified(3, '0') + ".pack";
+}
+
+bool
+RecitationPack::hasVerseFiles(const QDir& reciterDir, int surah)
+{
+  int count = Verse::surahVerseCount(surah);
+  for (int verse = 1; verse <= count; verse++) {
+    QString file = QString::number(surah).rightJustified(3, '0') +
+                   QString::number(verse).rightJustified(3, '0') + ".mp3";
+    if (!reciterDir.exists(file))
+      return false;
+  }
+
+  return true;
+}
+
+bool
+RecitationPack::pack(const QDir& reciterDir, int surah)
+{
+  if (!hasVerseFiles(reciterDir, surah))
+    return false;
+
+  int count = Verse::surahVerseCount(surah);
+  QStringList files;
+  for (int verse = 1; verse <= count; verse++) {
+    QString file = QString::number(surah).rightJustified(3, '0') +
+                   QString::number(verse).rightJustified(3, '0') + ".mp3";
+    files.append(reciterDir.absoluteFilePath(file));
+  }
+
+  QSaveFile out(reciterDir.absoluteFilePath(fileName(surah)));
+  if (!out.open(QIODevice::WriteOnly)) {
+    qWarning() << "Couldn't write" << out.fileName();
+    return false;
+  }
+
+  QDataStream stream(&out);
+  stream << s_magic << s_version << quint16(surah) << quint16(count);
+  qint64 offset = s_headerSize + count * s_entrySize;
+  for (const QString& file : files) {
+    qint64 size = QFileInfo(file).size();
+    stream << offset << size;
+    offset += size;
+  }
+
+  for (const QString& file : files) {
+    QFile in(file);
+    if (!in.open(QIODevice::ReadOnly) || out.write(in.readAll()) != in.size()) {
+      qWarning() << "Couldn't pack" << file;
+      out.cancelWriting();
+      return false;
+    }
+  }
+
+  if (!out.commit()) {
+    qWarning() << "Couldn't write" << out.fileName();
+    return false;
+  }
+
+  for (const QString& file : files)
+    QFile::remove(file);
+
+  return true;
+}
+
+bool
+RecitationPack::unpack(const QDir& reciterDir, int surah)
+{
+  QFile in(reciterDir.absoluteFilePath(fileName(surah)));
+  if (!in.open(QIODevice::ReadOnly))
+    return false;
+
+  std::optional<int> count = readHeader(in);
+  if (!count.has_value()) {
+    qWarning() << "Invalid recitation pack" << in.fileName();
+    return false;
+  }
+
+  for (int verse = 1; verse <= count.value(); verse++) {
+    std::optional<Entry> entry = readEntry(in, verse);
+    if (!entry.has_value() || !in.seek(entry->offset)) {
+      qWarning() << "Invalid recitation pack" << in.fileName();
+      return false;
+    }
+
+    QSaveFile out(reciterDir.absoluteFilePath(
+      QString::number(surah).rightJustified(3, '0') +
+      QString::number(verse).rightJustified(3, '0') + ".mp3"));
+    if (!out.open(QIODevice::WriteOnly) ||
+        out.write(in.read(entry->size)) != entry->size || !out.commit()) {
+      qWarning() << "Couldn't write" << out.fileName();
+      return false;
+    }
+  }
+
+  in.close();
+  return in.remove();
+}
+
+QString
+RecitationPack::verseSource(const QString& packPath, int verse)
+{
+  return packPath + '#' + QString::number(verse);
+}
+
+bool
+RecitationPack::isPackedSource(const QString& source)
+{
+  int hash = source.lastIndexOf('#');
+  return hash != -1 && QStringView(source).left(hash).endsWith(".pack");
+}
+
+QIODevice*
+RecitationPack::openSource(const QString& source, QObject* parent)
+{
+  if (!isPackedSource(source))
+    return nullptr;
+
+  int hash = source.lastIndexOf('#');
+  QFile file(source.left(hash));
+  if (!file.open(QIODevice::ReadOnly))
+    return nullptr;
+
+  std::optional<int> count = readHeader(file);
+  int verse = QStringView(source).mid(hash + 1).toInt();
+  if (!count.has_value() || verse < 1 || verse > count.value())
+    return nullptr;
+
+  std::optional<Entry> entry = readEntry(file, verse);
+  if (!entry.has_value())
+    return nullptr;
+
+  RangeDevice* device =
+    new RangeDevice(file.fileName(), entry->offset, entry->size, parent);
+  if (!device->open(QIODevice::ReadOnly)) {
+    delete device;
+    return nullptr;
+  }
+
+  return device;
+}
+
+std::optional<int>
+RecitationPack::readHeader(QFile& file)
+{
+  if (!file.seek(0))
+    return std::nullopt;
+
+  QDataStream stream(&file);
+  quint32 magic, version;
+  quint16 surah, count;
+  stream >> magic >> version >> surah >> count;
+  if (stream.status() != QDataStream::Ok || magic != s_magic ||
+      version != s_version || count != Verse::surahVerseCount(surah))
+    return std::nullopt;
+
+  return count;
+}
+
+std::optional<RecitationPack::Entry>
+RecitationPack::readEntry(QFile& file, int verse)
+{
+  if (!file.seek(s_headerSize + (verse - 1) * s_entrySize))
+    return std::nullopt;
+
+  QDataStream stream(&file);
+  Entry entry;
+  stream >> entry.offset >> entry.size;
+  if (stream.status() != QDataStream::Ok || entry.offset < 0 || entry.size < 0)
+    return std::nullopt;
+
+  return entry;
+}
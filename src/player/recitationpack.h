@@ -0,0 +1,121 @@
+/**
+ * @file recitationpack.h
+ * @brief Header file for the RecitationPack class
+ */
+
+#ifndef RECITATIONPACK_H
+#define RECITATIONPACK_H
+
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
+#include <QString>
+#include <optional>
+
+/**
+ * @class RecitationPack
+ * @brief Packs the verse recitations of a surah into a single file.
+ *
+ * A pack starts with a header and an index of the byte range of every verse,
+ * followed by the verse mp3 files as they were downloaded. Playing from a pack
+ * opens a single file per surah and reads a single index entry per verse,
+ * instead of a file per verse. Packing is reversible, unpacking writes back the
+ * original verse files.
+ */
+class RecitationPack
+{
+public:
+  /**
+   * @brief Gets the filename of the pack of a surah.
+   * @param surah The surah number.
+   * @return QString of the filename in the reciter directory, e.g. 002.pack
+   */
+  static QString fileName(int surah);
+  /**
+   * @brief Checks whether the verse files of a surah are all downloaded.
+   * @param reciterDir The directory of the reciter recitations.
+   * @param surah The surah number.
+   * @return Boolean indicating whether the surah can be packed.
+   */
+  static bool hasVerseFiles(const QDir& reciterDir, int surah);
+  /**
+   * @brief Packs the verse files of a surah and removes them, the surah must
+   * be completely downloaded, see hasVerseFiles().
+   * @param reciterDir The directory of the reciter recitations.
+   * @param surah The surah number.
+   * @return Boolean indicating whether the pack was written.
+   */
+  static bool pack(const QDir& reciterDir, int surah);
+  /**
+   * @brief Writes back the verse files of a pack and removes the pack.
+   * @param reciterDir The directory of the reciter recitations.
+   * @param surah The surah number.
+   * @return Boolean indicating whether all the verse files were written.
+   */
+  static bool unpack(const QDir& reciterDir, int surah);
+  /**
+   * @brief Builds the source of a packed verse, sources are passed around in
+   * place of file paths.
+   * @param packPath The absolute path of the pack.
+   * @param verse The verse number in the surah.
+   * @return QString of the verse source.
+   */
+  static QString verseSource(const QString& packPath, int verse);
+  /**
+   * @brief Checks whether the source refers to a packed verse.
+   * @param source A verse source or an audio file path.
+   * @return Boolean indicating whether the source is a packed verse.
+   */
+  static bool isPackedSource(const QString& source);
+  /**
+   * @brief Opens a device reading the verse of a packed verse source.
+   * @param source The verse source returned from verseSource().
+   * @param parent Pointer to the parent QObject of the device.
+   * @return Pointer to the opened QIODevice, nullptr if the verse couldn't be
+   * read.
+   */
+  static QIODevice* openSource(const QString& source, QObject* parent);
+
+private:
+  /**
+   * @brief Entry struct holds the byte range of a verse in the pack.
+   */
+  struct Entry
+  {
+    qint64 offset;
+    qint64 size;
+  };
+  /**
+   * @brief marks the beginning of a pack file
+   */
+  static const quint32 s_magic = 0x5143504b; // QCPK
+  /**
+   * @brief pack format version, should be incremented whenever the layout
+   * changes
+   */
+  static const quint32 s_version = 1;
+  /**
+   * @brief size of the pack header preceding the index
+   */
+  static const qint64 s_headerSize = 12;
+  /**
+   * @brief size of a single index entry
+   */
+  static const qint64 s_entrySize = 16;
+  /**
+   * @brief Reads and validates the header of an opened pack.
+   * @param file The opened pack file.
+   * @return The number of verses in the pack, std::nullopt if the header is
+   * invalid.
+   */
+  static std::optional<int> readHeader(QFile& file);
+  /**
+   * @brief Reads the index entry of a verse from an opened pack.
+   * @param file The opened pack file.
+   * @param verse The verse number in the surah.
+   * @return The Entry of the verse, std::nullopt if it couldn't be read.
+   */
+  static std::optional<Entry> readEntry(QFile& file, int verse);
+};
+
+#endif // RECITATIONPACK_H
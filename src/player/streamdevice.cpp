@@ -0,0 +1,106 @@
+/**
+ * @file streamdevice.cpp
+ * @brief Implementation file for StreamDevice
+ */
+
+#include "streamdevice.h"
+#include <QDeadlineTimer>
+#include <QThread>
+
+StreamDevice::StreamDevice(const QString& path,
+                           QSharedPointer<State> state,
+                           QObject* parent)
+  : QIODevice(parent)
+  , m_file(path)
+  , m_state(state)
+{
+}
+
+bool
+StreamDevice::open(OpenMode mode)
+{
+  if (mode != QIODevice::ReadOnly || !m_file.open(QIODevice::ReadOnly))
+    return false;
+
+  return QIODevice::open(mode);
+}
+
+void
+StreamDevice::close()
+{
+  m_file.close();
+  QIODevice::close();
+}
+
+bool
+StreamDevice::isSequential() const
+{
+  return false;
+}
+
+qint64
+StreamDevice::size() const
+{
+  QMutexLocker locker(&m_state->mutex);
+  return m_state->total >= 0 ? m_state->total : m_state->written;
+}
+
+qint64
+StreamDevice::bytesAvailable() const
+{
+  QMutexLocker locker(&m_state->mutex);
+  return std::max<qint64>(0, m_state->written - m_file.pos()) +
+         QIODevice::bytesAvailable();
+}
+
+bool
+StreamDevice::atEnd() const
+{
+  QMutexLocker locker(&m_state->mutex);
+  return m_state->done && pos() >= m_state->written;
+}
+
+bool
+StreamDevice::seek(qint64 pos)
+{
+  if (pos < 0 || pos > size() || !m_file.seek(pos))
+    return false;
+
+  return QIODevice::seek(pos);
+}
+
+void
+StreamDevice::notifyGrown()
+{
+  emit readyRead();
+}
+
+qint64
+StreamDevice::readData(char* data, qint64 maxSize)
+{
+  bool canWait = QThread::currentThread() != thread();
+  QDeadlineTimer deadline(s_readTimeoutMs);
+
+  QMutexLocker locker(&m_state->mutex);
+  while (m_file.pos() >= m_state->written && !m_state->done) {
+    if (!canWait || !m_state->grown.wait(&m_state->mutex, deadline))
+      return 0;
+  }
+
+  if (m_state->failed)
+    return -1;
+
+  qint64 left = m_state->written - m_file.pos();
+  if (left <= 0)
+    return 0;
+
+  return m_file.read(data, std::min(maxSize, left));
+}
+
+qint64
+StreamDevice::writeData(const char* data, qint64 maxSize)
+{
+  Q_UNUSED(data);
+  Q_UNUSED(maxSize);
+  return -1;
+}
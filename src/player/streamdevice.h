@@ -0,0 +1,84 @@
+/**
+ * @file streamdevice.h
+ * @brief Header file for the StreamDevice class
+ */
+
+#ifndef STREAMDEVICE_H
+#define STREAMDEVICE_H
+
+#include <QFile>
+#include <QIODevice>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QWaitCondition>
+
+/**
+ * @class StreamDevice
+ * @brief Read-only device over a file that is still being downloaded.
+ *
+ * The download writes the file and reports its progress through the shared
+ * StreamDevice::State, every device opened on the file reads up to the written
+ * size. Media backends read from their own threads, a read past the written
+ * size blocks there until more data is written, the download ends or the
+ * timeout expires. Reads from the thread of the device never block, they
+ * return what is written and readyRead() is emitted as the file grows.
+ */
+class StreamDevice : public QIODevice
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief State struct holds the download progress shared between the
+   * download and the devices reading the file.
+   */
+  struct State
+  {
+    QMutex mutex;
+    QWaitCondition grown;
+    qint64 written = 0;  ///< Bytes written to the file.
+    qint64 total = -1;   ///< Size of the complete file, -1 if unknown.
+    bool done = false;   ///< Indicates whether the download ended.
+    bool failed = false; ///< Indicates whether the download failed.
+  };
+  /**
+   * @brief Constructs a StreamDevice object.
+   * @param path The absolute path of the file being downloaded.
+   * @param state The progress of the download.
+   * @param parent Pointer to the parent QObject.
+   */
+  StreamDevice(const QString& path,
+               QSharedPointer<State> state,
+               QObject* parent = nullptr);
+  /**
+   * @brief Opens the file, only QIODevice::ReadOnly is supported.
+   * @param mode The QIODevice::OpenMode to open the device in.
+   * @return Boolean indicating whether the file was opened.
+   */
+  bool open(OpenMode mode) override;
+  void close() override;
+  bool isSequential() const override;
+  qint64 size() const override;
+  qint64 bytesAvailable() const override;
+  bool atEnd() const override;
+  bool seek(qint64 pos) override;
+  /**
+   * @brief Notifies readers in the device thread that the file grew, called
+   * by the download after updating the state.
+   */
+  void notifyGrown();
+
+protected:
+  qint64 readData(char* data, qint64 maxSize) override;
+  qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+  /**
+   * @brief Maximum time a read waits for the download to progress.
+   */
+  static const int s_readTimeoutMs = 15000;
+  QFile m_file;                  ///< Reader of the downloaded file.
+  QSharedPointer<State> m_state; ///< Progress of the download.
+};
+
+#endif // STREAMDEVICE_H
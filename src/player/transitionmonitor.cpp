@@ -0,0 +1,235 @@
+/**
+ * @file transitionmonitor.cpp
+ * @brief Implementation file for TransitionMonitor
+ */
+
+#include "transitionmonitor.h"
+#include <QDebug>
+#include <QJsonArray>
+#include <algorithm>
+#include <cmath>
+
+void
+TransitionMonitor::Histogram::add(double ms)
+{
+  const QList<double>& bounds = buckets();
+  if (counts.isEmpty())
+    counts.fill(0, bounds.size() + 1);
+
+  int bucket = std::lower_bound(bounds.begin(), bounds.end(), ms) -
+               bounds.begin();
+  counts[bucket]++;
+  count++;
+  sumMs += ms;
+  maxMs = std::max(maxMs, ms);
+
+  if (recent.size() == s_recentSamples)
+    recent.removeFirst();
+  recent.append(ms);
+}
+
+double
+TransitionMonitor::Histogram::percentile(int p) const
+{
+  if (recent.isEmpty())
+    return 0;
+
+  QList<double> sorted = recent;
+  std::sort(sorted.begin(), sorted.end());
+  qsizetype rank = std::ceil(p / 100.0 * sorted.size());
+  return sorted.at(std::clamp<qsizetype>(rank - 1, 0, sorted.size() - 1));
+}
+
+TransitionMonitor&
+TransitionMonitor::getInstance()
+{
+  static TransitionMonitor monitor;
+  return monitor;
+}
+
+TransitionMonitor::TransitionMonitor()
+{
+  m_clock.start();
+}
+
+const QList<double>&
+TransitionMonitor::buckets()
+{
+  static const QList<double> bounds = { 1,  2,   5,   10,  20,   50,
+                                        100, 200, 500, 1000, 2000 };
+  return bounds;
+}
+
+void
+TransitionMonitor::setReciter(const QString& reciter)
+{
+  m_reciter = reciter;
+}
+
+void
+TransitionMonitor::mark(Stage stage)
+{
+  qint64 time = now();
+  switch (stage) {
+    case EndOfMedia:
+      cancel();
+      m_open = true;
+      m_end = time;
+      break;
+    case Decision:
+      if (m_open)
+        m_decision = time;
+      break;
+    case SourceSet:
+      // a verse loaded without the previous one ending, e.g. on navigation,
+      // only has its load time recorded
+      if (!m_open) {
+        cancel();
+        m_open = true;
+      }
+      m_source = time;
+      m_loaded = -1;
+      break;
+    case MediaLoaded:
+      if (!m_open || m_source < 0 || m_loaded >= 0)
+        break;
+      m_loaded = time;
+      m_histograms[m_reciter].load.add((m_loaded - m_source) / 1e6);
+      emit recorded();
+      break;
+    case FirstPosition:
+      if (!m_open)
+        break;
+      if (m_end >= 0) {
+        double latency = (time - m_end) / 1e6;
+        m_histograms[m_reciter].transition.add(latency);
+
+        auto since = [this](qint64 t) {
+          return t < 0 ? QString("-")
+                       : QString::number((t - m_end) / 1e6, 'f', 1);
+        };
+        qDebug().noquote() << QString("Verse transition %0 ms: decision %1, "
+                                      "source %2, loaded %3")
+                                .arg(QString::number(latency, 'f', 1),
+                                     since(m_decision),
+                                     since(m_source),
+                                     since(m_loaded));
+        emit recorded();
+      }
+      cancel();
+      break;
+  }
+}
+
+void
+TransitionMonitor::cancel()
+{
+  m_open = false;
+  m_end = m_decision = m_source = m_loaded = -1;
+}
+
+void
+TransitionMonitor::reset()
+{
+  cancel();
+  m_histograms.clear();
+  emit recorded();
+}
+
+QString
+TransitionMonitor::report() const
+{
+  auto line = [](const QString& name, const Histogram& h) {
+    if (!h.count)
+      return QString("  %0: no samples").arg(name);
+    return QString("  %0: %1 samples, mean %2 ms, p50 %3 ms, p90 %4 ms, "
+                   "p99 %5 ms, max %6 ms")
+      .arg(name)
+      .arg(h.count)
+      .arg(h.sumMs / h.count, 0, 'f', 1)
+      .arg(h.percentile(50), 0, 'f', 1)
+      .arg(h.percentile(90), 0, 'f', 1)
+      .arg(h.percentile(99), 0, 'f', 1)
+      .arg(h.maxMs, 0, 'f', 1);
+  };
+  auto distribution = [](const Histogram& h) {
+    QStringList parts;
+    const QList<double>& bounds = buckets();
+    for (int i = 0; i < h.counts.size(); i++) {
+      if (!h.counts.at(i))
+        continue;
+      QString bucket = i < bounds.size()
+                         ? QString("<=%0").arg(bounds.at(i))
+                         : QString(">%0").arg(bounds.last());
+      parts.append(QString("%0: %1").arg(bucket).arg(h.counts.at(i)));
+    }
+    return "    " + parts.join(", ");
+  };
+
+  QStringList lines;
+  for (auto it = m_histograms.cbegin(); it != m_histograms.cend(); ++it) {
+    lines.append(it.key());
+    lines.append(line("transition", it->transition));
+    if (it->transition.count)
+      lines.append(distribution(it->transition));
+    lines.append(line("source load", it->load));
+    if (it->load.count)
+      lines.append(distribution(it->load));
+  }
+
+  return lines.join('\n');
+}
+
+void
+TransitionMonitor::logReport() const
+{
+  if (m_histograms.isEmpty())
+    return;
+
+  qInfo().noquote() << "Verse transition latency (ms)\n" + report();
+}
+
+QJsonObject
+TransitionMonitor::toJson() const
+{
+  QJsonObject reciters;
+  for (auto it = m_histograms.cbegin(); it != m_histograms.cend(); ++it) {
+    QJsonObject obj;
+    obj["transition"] = histogramJson(it->transition);
+    obj["sourceLoad"] = histogramJson(it->load);
+    reciters[it.key()] = obj;
+  }
+
+  QJsonArray bounds;
+  for (double b : buckets())
+    bounds.append(b);
+
+  QJsonObject obj;
+  obj["bucketsMs"] = bounds;
+  obj["reciters"] = reciters;
+  return obj;
+}
+
+QJsonObject
+TransitionMonitor::histogramJson(const Histogram& h)
+{
+  QJsonArray counts;
+  for (int c : h.counts)
+    counts.append(c);
+
+  QJsonObject obj;
+  obj["count"] = h.count;
+  obj["meanMs"] = h.count ? h.sumMs / h.count : 0;
+  obj["p50Ms"] = h.percentile(50);
+  obj["p90Ms"] = h.percentile(90);
+  obj["p99Ms"] = h.percentile(99);
+  obj["maxMs"] = h.maxMs;
+  obj["counts"] = counts;
+  return obj;
+}
+
+qint64
+TransitionMonitor::now() const
+{
+  return m_clock.nsecsElapsed();
+}
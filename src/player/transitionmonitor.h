@@ -0,0 +1,155 @@
+/**
+ * @file transitionmonitor.h
+ * @brief Header file for the TransitionMonitor class
+ */
+
+#ifndef TRANSITIONMONITOR_H
+#define TRANSITIONMONITOR_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QString>
+
+/**
+ * @class TransitionMonitor
+ * @brief Measures the gap between consecutive verses during playback.
+ *
+ * The player and the playback controller mark the stages of every verse
+ * transition: the end of the playing verse, the strategy decision, the new
+ * source, the media being loaded and the first position advance of the new
+ * verse. The transition latency runs from the end of the verse to the first
+ * position advance, the source load time from the new source to the loaded
+ * media. Both are collected in histograms per reciter, reported to the log
+ * when playback stops and shown in the PlaybackStatsDialog.
+ */
+class TransitionMonitor : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Stage enum represents the marked stages of a verse transition.
+   */
+  enum Stage
+  {
+    EndOfMedia,   ///< The playing verse ended.
+    Decision,     ///< The strategy picked the next verse.
+    SourceSet,    ///< The source of the verse was set.
+    MediaLoaded,  ///< The source was loaded or buffered.
+    FirstPosition ///< The position of the new verse advanced.
+  };
+  /**
+   * @brief Histogram struct collects the samples of a single metric.
+   */
+  struct Histogram
+  {
+    QList<int> counts;    ///< Samples in each bucket of buckets().
+    qint64 count = 0;     ///< Number of samples.
+    double sumMs = 0;     ///< Sum of the samples.
+    double maxMs = 0;     ///< Largest sample.
+    QList<double> recent; ///< Latest samples, used for the percentiles.
+    /**
+     * @brief Adds a sample to the histogram.
+     * @param ms The sample in milliseconds.
+     */
+    void add(double ms);
+    /**
+     * @brief Gets a percentile of the recent samples.
+     * @param p The percentile, between 0 and 100.
+     * @return The percentile in milliseconds, 0 if there are no samples.
+     */
+    double percentile(int p) const;
+  };
+  /**
+   * @brief Gets a reference to the single class instance.
+   * @return Reference to the static class instance.
+   */
+  static TransitionMonitor& getInstance();
+  /**
+   * @brief Sets the reciter the following transitions are recorded for.
+   * @param reciter The display name of the reciter.
+   */
+  void setReciter(const QString& reciter);
+  /**
+   * @brief Marks a stage of the current transition, a transition starts at
+   * EndOfMedia or at SourceSet when the verse is changed by the user.
+   * @param stage The reached Stage.
+   */
+  void mark(Stage stage);
+  /**
+   * @brief Drops the current transition, e.g. when playback stops.
+   */
+  void cancel();
+  /**
+   * @brief Removes all the recorded samples.
+   */
+  void reset();
+  /**
+   * @brief Builds a human readable report of the histograms.
+   * @return QString of the report lines.
+   */
+  QString report() const;
+  /**
+   * @brief Writes the report to the log if any transition was recorded.
+   */
+  void logReport() const;
+  /**
+   * @brief Gets the histograms of every reciter.
+   * @return QJsonObject of the histograms by reciter.
+   */
+  QJsonObject toJson() const;
+  /**
+   * @brief Gets the upper bounds of the histogram buckets.
+   * @return List of bucket bounds in milliseconds, the last bucket has no
+   * upper bound.
+   */
+  static const QList<double>& buckets();
+
+signals:
+  /**
+   * @brief Emitted when a sample is recorded or the samples are reset.
+   */
+  void recorded();
+
+private:
+  TransitionMonitor();
+  /**
+   * @brief Histograms struct holds the metrics of a single reciter.
+   */
+  struct Histograms
+  {
+    Histogram transition;
+    Histogram load;
+  };
+  /**
+   * @brief Maximum number of recent samples kept for the percentiles.
+   */
+  static const int s_recentSamples = 4096;
+  /**
+   * @brief Converts a histogram to JSON.
+   * @param h The Histogram to convert.
+   * @return QJsonObject of the histogram.
+   */
+  static QJsonObject histogramJson(const Histogram& h);
+  /**
+   * @brief Gets the time elapsed since the monitor was created.
+   * @return Elapsed time in nanoseconds.
+   */
+  qint64 now() const;
+  QElapsedTimer m_clock;
+  QString m_reciter;
+  /**
+   * @brief Histograms by reciter display name.
+   */
+  QMap<QString, Histograms> m_histograms;
+  bool m_open = false;    ///< Indicates whether a transition is in progress.
+  qint64 m_end = -1;      ///< Time the previous verse ended.
+  qint64 m_decision = -1; ///< Time of the strategy decision.
+  qint64 m_source = -1;   ///< Time the source was set.
+  qint64 m_loaded = -1;   ///< Time the source was loaded.
+};
+
+#endif // TRANSITIONMONITOR_H
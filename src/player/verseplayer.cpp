@@ -5,21 +5,96 @@
 
 #include "verseplayer.h"
 #include <player/impl/continuousplaybackstrategy.h>
+#include <player/recitationpack.h>
+#include <player/transitionmonitor.h>
+#include <player/versestreamer.h>
 #include <utils/dirmanager.h>
 
 VersePlayer::VersePlayer(QObject* parent, int reciterIdx)
-  : QMediaPlayer(parent)
+  : QObject(parent)
   , m_reciter(reciterIdx)
-  , m_output(new QAudioOutput(this))
   , m_activeVerse(Verse::getCurrent())
   , m_reciterDir(
       DirManager::getInstance().downloadsDir().absoluteFilePath("recitations"))
   , m_reciters(Reciter::reciters)
+  , m_inventory(RecitationIndex::getInstance())
 {
-  setAudioOutput(m_output);
+  m_active = createPlayer();
+  m_standby = createPlayer();
 
   m_reciterDir.cd(m_reciters.at(m_reciter).baseDirName());
+  TransitionMonitor::getInstance().setReciter(reciterName());
   loadActiveVerse();
+
+  connect(&VerseStreamer::getInstance(),
+          &VerseStreamer::failed,
+          this,
+          [this](int reciter, const Verse& v) {
+            if (reciter == m_reciter && v == m_activeVerse)
+              emit missingVerseFile(m_reciter, v.surah());
+          });
+}
+
+QMediaPlayer*
+VersePlayer::createPlayer()
+{
+  QMediaPlayer* player = new QMediaPlayer(this);
+  player->setAudioOutput(new QAudioOutput(player));
+
+  // only the active player is visible outside of the class
+  connect(player,
+          &QMediaPlayer::positionChanged,
+          this,
+          [this, player](qint64 position) {
+            if (player == m_active)
+              emit positionChanged(position);
+          });
+  connect(player,
+          &QMediaPlayer::durationChanged,
+          this,
+          [this, player](qint64 duration) {
+            if (player == m_active)
+              emit durationChanged(duration);
+          });
+  connect(player,
+          &QMediaPlayer::playbackStateChanged,
+          this,
+          [this, player](QMediaPlayer::PlaybackState state) {
+            if (player == m_active)
+              emit playbackStateChanged(state);
+          });
+  connect(player,
+          &QMediaPlayer::mediaStatusChanged,
+          this,
+          [this, player](QMediaPlayer::MediaStatus status) {
+            playerStatusChanged(player, status);
+          });
+
+  return player;
+}
+
+void
+VersePlayer::playerStatusChanged(QMediaPlayer* player,
+                                 QMediaPlayer::MediaStatus status)
+{
+  if (player != m_active)
+    return;
+
+  // start the preloaded verse before anyone reacts to the end of the active
+  // one, the handover is taken when the next verse is activated
+  if (status == QMediaPlayer::EndOfMedia && m_isOn &&
+      m_standbyVerse.has_value()) {
+    std::swap(m_active, m_standby);
+    m_handover = m_standbyVerse;
+    m_standbyVerse.reset();
+    m_active->play();
+    if (m_handover->number() != 0)
+      m_verseFile = constructVerseFilename(m_handover.value());
+
+    emit durationChanged(m_active->duration());
+  }
+
+  emit mediaStatusChanged(status);
 }
 
 bool
@@ -28,38 +103,170 @@ VersePlayer::isOn() const
   return m_isOn;
 }
 
+bool
+VersePlayer::isPlaying() const
+{
+  return playbackState() == QMediaPlayer::PlayingState;
+}
+
+QMediaPlayer::PlaybackState
+VersePlayer::playbackState() const
+{
+  return m_engine ? m_engine->playbackState() : m_active->playbackState();
+}
+
+qint64
+VersePlayer::duration() const
+{
+  return m_engine ? m_engine->duration() : m_active->duration();
+}
+
+qint64
+VersePlayer::position() const
+{
+  return m_engine ? m_engine->position() : m_active->position();
+}
+
 void
 VersePlayer::play()
 {
   m_isOn = true;
-  QMediaPlayer::play();
+  if (m_engine)
+    m_engine->play();
+  else
+    m_active->play();
 }
 
 void
 VersePlayer::pause()
 {
   m_isOn = false;
-  QMediaPlayer::pause();
+  if (m_engine)
+    m_engine->pause();
+  else
+    m_active->pause();
 }
 
 void
 VersePlayer::stop()
 {
   m_isOn = false;
-  QMediaPlayer::stop();
+  m_handover.reset();
+  if (m_engine)
+    m_engine->stop();
+  else
+    m_active->stop();
+}
+
+void
+VersePlayer::setPosition(qint64 position)
+{
+  if (m_engine)
+    m_engine->setPosition(position);
+  else
+    m_active->setPosition(position);
+}
+
+void
+VersePlayer::setGapless(bool gapless)
+{
+  m_gapless = gapless;
+  if (!m_gapless)
+    clearStandby();
+}
+
+void
+VersePlayer::setStreaming(bool streaming)
+{
+  m_streaming = streaming;
+}
+
+void
+VersePlayer::cancelStreams()
+{
+  VerseStreamer::getInstance().cancel();
+}
+
+void
+VersePlayer::setPcmEngine(bool enabled, int cacheMb)
+{
+  if (enabled == (m_engine != nullptr))
+    return;
+
+  stop();
+  clearStandby();
+  if (!enabled) {
+    delete m_engine;
+    m_engine = nullptr;
+    loadActiveVerse();
+    return;
+  }
+
+  setDeckSource(m_active, QString());
+  m_engine = new PcmEngine(this, cacheMb);
+  m_engine->setDevice(m_active->audioOutput()->device());
+  m_engine->setVolume(m_active->audioOutput()->volume());
+  connect(m_engine,
+          &PcmEngine::positionChanged,
+          this,
+          &VersePlayer::positionChanged);
+  connect(m_engine,
+          &PcmEngine::durationChanged,
+          this,
+          &VersePlayer::durationChanged);
+  connect(m_engine,
+          &PcmEngine::playbackStateChanged,
+          this,
+          &VersePlayer::playbackStateChanged);
+  connect(m_engine,
+          &PcmEngine::mediaStatusChanged,
+          this,
+          &VersePlayer::mediaStatusChanged);
+  connect(m_engine, &PcmEngine::advanced, this, &VersePlayer::engineAdvanced);
+  loadActiveVerse();
+}
+
+PcmEngine*
+VersePlayer::pcmEngine() const
+{
+  return m_engine;
+}
+
+void
+VersePlayer::reportStats() const
+{
+  if (m_engine)
+    m_engine->reportStats();
+}
+
+void
+VersePlayer::engineAdvanced()
+{
+  // same handover as the standby player, the queued verse is already heard
+  m_handover = m_standbyVerse;
+  m_standbyVerse.reset();
+  if (m_handover.has_value() && m_handover->number() != 0)
+    m_verseFile = constructVerseFilename(m_handover.value());
+
+  emit mediaStatusChanged(QMediaPlayer::EndOfMedia);
 }
 
 void
 VersePlayer::changeUsedAudioDevice(QAudioDevice dev)
 {
-  m_output->setDevice(dev);
-  setAudioOutput(m_output);
+  for (QMediaPlayer* player : { m_active, m_standby })
+    player->audioOutput()->setDevice(dev);
+  if (m_engine)
+    m_engine->setDevice(dev);
 }
 
 void
 VersePlayer::setPlayerVolume(qreal volume)
 {
-  m_output->setVolume(volume);
+  for (QMediaPlayer* player : { m_active, m_standby })
+    player->audioOutput()->setVolume(volume);
+  if (m_engine)
+    m_engine->setVolume(volume);
 }
 
 QString
@@ -92,6 +299,9 @@ VersePlayer::changeReciter(int reciterIdx)
     m_reciterDir.cdUp();
     m_reciterDir.cd(m_reciters.at(reciterIdx).baseDirName());
     m_reciter = reciterIdx;
+    clearStandby();
+    cancelStreams();
+    TransitionMonitor::getInstance().setReciter(reciterName());
   }
 
   return loadActiveVerse();
@@ -100,31 +310,166 @@ VersePlayer::changeReciter(int reciterIdx)
 bool
 VersePlayer::setVerseFile(const QString& newVerseFilename)
 {
-  setSource(QUrl());
+  setSource(QString());
 
-  if (!m_reciterDir.exists(newVerseFilename)) {
+  std::optional<QString> source = verseSource(m_activeVerse, true);
+  if (!source.has_value()) {
     qDebug() << "file " + newVerseFilename + " is missing.";
     emit missingVerseFile(m_reciter, m_activeVerse.surah());
     return false;
   }
 
   m_verseFile = newVerseFilename;
-  setSource(QUrl::fromLocalFile(m_reciterDir.filePath(m_verseFile)));
+  setSource(source.value());
 
   return true;
 }
 
+void
+VersePlayer::setSource(const QString& path)
+{
+  if (!path.isEmpty())
+    TransitionMonitor::getInstance().mark(TransitionMonitor::SourceSet);
+  if (m_engine)
+    m_engine->load(path);
+  else
+    setDeckSource(m_active, path);
+}
+
+void
+VersePlayer::setDeckSource(QMediaPlayer* deck, const QString& path)
+{
+  // the device of a packed verse lives as long as the deck plays it
+  QIODevice* previous = m_devices.take(deck);
+  QIODevice* device = RecitationPack::openSource(path, this);
+  if (!device)
+    device = VerseStreamer::getInstance().openSource(path, this);
+  if (device) {
+    // the name only hints the container format to the backend
+    deck->setSourceDevice(device, QUrl("verse.mp3"));
+    m_devices.insert(deck, device);
+  } else {
+    deck->setSource(path.isEmpty() ? QUrl() : QUrl::fromLocalFile(path));
+  }
+
+  if (previous)
+    previous->deleteLater();
+}
+
 bool
 VersePlayer::loadActiveVerse()
 {
+  m_handover.reset();
+
+  // the verse may already be primed, e.g. when navigating to the next verse
+  if (!m_engine && m_standbyVerse.has_value() &&
+      m_standbyVerse.value() == m_activeVerse) {
+    setDeckSource(m_active, QString());
+    std::swap(m_active, m_standby);
+    m_standbyVerse.reset();
+    m_active->stop();
+    if (m_activeVerse.number() != 0)
+      m_verseFile = constructVerseFilename(m_activeVerse);
+
+    emit durationChanged(m_active->duration());
+    return true;
+  }
+
   if (m_activeVerse.number() == 0) {
-    setSource(QUrl::fromLocalFile(m_reciters.at(m_reciter).basmallahPath()));
+    setSource(m_reciters.at(m_reciter).basmallahPath());
     return true;
   }
 
   return setVerseFile(constructVerseFilename(m_activeVerse));
 }
 
+void
+VersePlayer::preload(const std::optional<Verse>& next)
+{
+  if (!m_gapless || !next.has_value()) {
+    clearStandby();
+    return;
+  }
+
+  if (m_standbyVerse.has_value() && m_standbyVerse.value() == next.value())
+    return;
+
+  std::optional<QString> source = verseSource(next.value(), true);
+  if (!source.has_value()) {
+    clearStandby();
+    return;
+  }
+
+  m_standbyVerse = next;
+  if (m_engine) {
+    m_engine->queue(source.value());
+    return;
+  }
+
+  // pausing a stopped player opens the media and fills the decoder buffers
+  // without any output
+  setDeckSource(m_standby, source.value());
+  m_standby->pause();
+}
+
+void
+VersePlayer::prefetch(const QList<Verse>& verses)
+{
+  for (const Verse& v : verses) {
+    // partial streams are decoded once they are played
+    bool downloaded = v.number() == 0 ||
+                      m_inventory.hasVerse(m_reciter, v.surah(), v.number());
+    std::optional<QString> source = verseSource(v, false);
+    if (m_engine && downloaded && source.has_value())
+      m_engine->cache()->request(source.value());
+  }
+}
+
+bool
+VersePlayer::takeHandover(const Verse& v)
+{
+  bool handedOver = m_handover.has_value() && m_handover.value() == v;
+  m_handover.reset();
+  return handedOver;
+}
+
+bool
+VersePlayer::handoverPending() const
+{
+  return m_handover.has_value();
+}
+
+std::optional<QString>
+VersePlayer::verseSource(const Verse& v, bool urgent)
+{
+  if (v.number() == 0) {
+    if (!m_inventory.hasBasmallah(m_reciter))
+      return std::nullopt;
+    return m_reciters.at(m_reciter).basmallahPath();
+  }
+
+  if (!m_inventory.hasVerse(m_reciter, v.surah(), v.number())) {
+    if (!m_streaming)
+      return std::nullopt;
+    return VerseStreamer::getInstance().fetch(m_reciter, v, urgent);
+  }
+
+  if (m_inventory.isPacked(m_reciter, v.surah()))
+    return RecitationPack::verseSource(
+      m_reciterDir.filePath(RecitationPack::fileName(v.surah())), v.number());
+
+  return m_reciterDir.filePath(constructVerseFilename(v));
+}
+
+void
+VersePlayer::clearStandby()
+{
+  m_standbyVerse.reset();
+  setDeckSource(m_standby, QString());
+  if (m_engine)
+    m_engine->queue(QString());
+}
+
 QString
 VersePlayer::reciterName() const
 {
@@ -134,7 +479,7 @@ VersePlayer::reciterName() const
 QAudioOutput*
 VersePlayer::getOutput() const
 {
-  return m_output;
+  return m_active->audioOutput();
 }
 
 QString
@@ -10,21 +10,36 @@
 #include <QAudioDevice>
 #include <QAudioOutput>
 #include <QDir>
+#include <QHash>
+#include <QIODevice>
 #include <QMediaPlayer>
 #include <QObject>
 #include <QPointer>
+#include <optional>
+#include <player/pcmengine.h>
 #include <types/reciter.h>
 #include <types/verse.h>
+#include <utils/recitationindex.h>
 
 /**
  * @class VersePlayer
  * @brief Responsible for the playback of Quran verse recitations.
  *
- * This class extends QMediaPlayer and manages the playback of Quranic verses by
- * interacting with audio files. It supports changing reciters, setting audio
- * output devices, and loading verse files for playback.
+ * This class manages the playback of Quranic verses by interacting with audio
+ * files. It supports changing reciters, setting audio output devices, and
+ * loading verse files for playback.
+ *
+ * Playback is double-buffered: the active verse plays on one QMediaPlayer
+ * while the next verse is loaded and primed on a standby player. At the end
+ * of the active verse the standby player starts immediately and the two
+ * players swap roles, so there is no gap while the next file is opened. The
+ * signals of the active player are forwarded as the VersePlayer signals.
+ *
+ * In the PCM engine mode, verses are decoded once and played from memory by a
+ * PcmEngine instead, the next verse is queued in the engine and starts on the
+ * following sample.
  */
-class VersePlayer : public QMediaPlayer
+class VersePlayer : public QObject
 {
   Q_OBJECT
 
@@ -53,6 +68,65 @@ public:
    * loaded.
    */
   bool loadActiveVerse();
+  /**
+   * @brief Loads and primes the given verse on the standby player so it
+   * starts without a gap at the end of the active verse.
+   * @param next The verse played after the active verse, std::nullopt if
+   * playback ends with the active verse.
+   */
+  void preload(const std::optional<Verse>& next);
+  /**
+   * @brief Prepares the given verses ahead of time, missing verses are
+   * downloaded in the on-demand mode and downloaded verses are decoded in the
+   * PCM engine mode.
+   * @param verses The verses played after the active verse.
+   */
+  void prefetch(const QList<Verse>& verses);
+  /**
+   * @brief Checks whether the given verse is already playing after a gapless
+   * handover, and clears the handover.
+   * @param v The newly activated verse.
+   * @return Boolean indicating whether the verse does not need to be loaded.
+   */
+  bool takeHandover(const Verse& v);
+  /**
+   * @brief Checks whether a handed over verse is playing and was not taken
+   * yet.
+   * @return Boolean indicating whether a handover is pending.
+   */
+  bool handoverPending() const;
+  /**
+   * @brief Enables or disables the double-buffered playback.
+   * @param gapless Boolean indicating whether the next verse is preloaded.
+   */
+  void setGapless(bool gapless);
+  /**
+   * @brief Enables or disables the on-demand mode, missing verses are
+   * downloaded by the VerseStreamer and played while downloading instead of
+   * stopping playback.
+   * @param streaming Boolean indicating whether missing verses are streamed.
+   */
+  void setStreaming(bool streaming);
+  /**
+   * @brief Cancels the downloads of streamed verses, e.g. when playback
+   * stops.
+   */
+  void cancelStreams();
+  /**
+   * @brief Switches between the QMediaPlayer playback and the PCM engine.
+   * @param enabled Boolean indicating whether to play through a PcmEngine.
+   * @param cacheMb Maximum size of the PCM cache in megabytes.
+   */
+  void setPcmEngine(bool enabled, int cacheMb);
+  /**
+   * @brief Gets the PCM engine used for playback.
+   * @return Pointer to the PcmEngine, nullptr if the engine is not enabled.
+   */
+  PcmEngine* pcmEngine() const;
+  /**
+   * @brief Logs the PCM cache usage if the PCM engine is enabled.
+   */
+  void reportStats() const;
   /**
    * @brief Gets the name of the currently selected reciter.
    * @return QString containing the reciter's display name.
@@ -73,6 +147,26 @@ public:
    * @return Boolean indicating whether the player is on.
    */
   bool isOn() const;
+  /**
+   * @brief Checks if the active verse is currently playing.
+   * @return Boolean indicating whether the active player is playing.
+   */
+  bool isPlaying() const;
+  /**
+   * @brief Gets the playback state of the active player.
+   * @return QMediaPlayer::PlaybackState of the active player.
+   */
+  QMediaPlayer::PlaybackState playbackState() const;
+  /**
+   * @brief Gets the duration of the active verse.
+   * @return Duration in milliseconds.
+   */
+  qint64 duration() const;
+  /**
+   * @brief Gets the playback position in the active verse.
+   * @return Position in milliseconds.
+   */
+  qint64 position() const;
 
 public slots:
   /**
@@ -88,6 +182,11 @@ public slots:
    * @brief Stops playback and sets the player state to off.
    */
   void stop();
+  /**
+   * @brief Seeks the active verse to the given position.
+   * @param position Position in milliseconds.
+   */
+  void setPosition(qint64 position);
   /**
    * @brief Plays the mp3 file corresponding to the current active verse.
    */
@@ -113,21 +212,93 @@ public slots:
 
 signals:
   /**
-   * @brief Emitted when a verse file is missing.
+   * @brief Emitted when a verse file is missing, or couldn't be downloaded in
+   * the on-demand mode.
    * @param reciterIdx Index of the reciter.
    * @param surah The surah number associated with the missing verse file.
    */
   void missingVerseFile(int reciterIdx, int surah);
+  /**
+   * @brief Forwarded QMediaPlayer::positionChanged of the active player.
+   */
+  void positionChanged(qint64 position);
+  /**
+   * @brief Forwarded QMediaPlayer::durationChanged of the active player.
+   */
+  void durationChanged(qint64 duration);
+  /**
+   * @brief Forwarded QMediaPlayer::playbackStateChanged of the active player.
+   */
+  void playbackStateChanged(QMediaPlayer::PlaybackState state);
+  /**
+   * @brief Forwarded QMediaPlayer::mediaStatusChanged of the active player.
+   */
+  void mediaStatusChanged(QMediaPlayer::MediaStatus status);
 
 private:
+  /**
+   * @brief Creates a player with its own audio output and forwards its
+   * signals while it is the active player.
+   * @return Pointer to the created QMediaPlayer.
+   */
+  QMediaPlayer* createPlayer();
+  /**
+   * @brief Handles the media status of both players, hands playback over to
+   * the standby player at the end of the active verse.
+   * @param player The player that emitted the status.
+   * @param status The new media status.
+   */
+  void playerStatusChanged(QMediaPlayer* player,
+                           QMediaPlayer::MediaStatus status);
+  /**
+   * @brief Gets the source of the given verse for the current reciter.
+   * @param v The verse to get the source for.
+   * @param urgent Boolean indicating whether a missing verse is needed now,
+   * only used in the on-demand mode.
+   * @return QString of the verse file path, its packed source, see
+   * RecitationPack, or the partial file it is streamed from, std::nullopt if
+   * the file is missing.
+   */
+  std::optional<QString> verseSource(const Verse& v, bool urgent);
+  /**
+   * @brief Loads a file in the active player or the PCM engine.
+   * @param path The absolute path of the file or a packed verse source, empty
+   * to unload.
+   */
+  void setSource(const QString& path);
+  /**
+   * @brief Loads a file in one of the players, packed verses are read through
+   * a RangeDevice owned by the player.
+   * @param deck The player to load the file in.
+   * @param path The absolute path of the file or a packed verse source, empty
+   * to unload.
+   */
+  void setDeckSource(QMediaPlayer* deck, const QString& path);
+  /**
+   * @brief Handles the PCM engine starting the queued verse.
+   */
+  void engineAdvanced();
+  /**
+   * @brief Unloads the standby player.
+   */
+  void clearStandby();
   Verse& m_activeVerse; ///< Current active verse.
   QDir m_reciterDir;    ///< Directory of the current reciter's recitations.
   const QList<Reciter>& m_reciters; ///< List of available reciters.
+  RecitationIndex& m_inventory;     ///< Index of the downloaded recitations.
   bool m_isOn = false;              ///< Indicates whether the player is on.
-  int m_reciter = 0;   ///< Index of the currently selected reciter.
-  QString m_verseFile; ///< Filename of the current verse.
-  QPointer<QAudioOutput>
-    m_output; ///< Pointer to the QAudioOutput object for playback control.
+  bool m_gapless = true; ///< Indicates whether the next verse is preloaded.
+  bool m_streaming = false; ///< Indicates whether missing verses are streamed.
+  int m_reciter = 0;     ///< Index of the currently selected reciter.
+  QString m_verseFile;   ///< Filename of the current verse.
+  QMediaPlayer* m_active;  ///< Player of the active verse.
+  QMediaPlayer* m_standby; ///< Player of the preloaded next verse.
+  std::optional<Verse> m_standbyVerse; ///< Verse loaded in m_standby.
+  QHash<QMediaPlayer*, QIODevice*>
+    m_devices; ///< Devices of the packed verses loaded in the players.
+  std::optional<Verse>
+    m_handover; ///< Verse playing after a handover, until it is activated.
+  PcmEngine* m_engine = nullptr; ///< Engine of the PCM engine mode.
 };
 
 #endif // VERSEPLAYER_H
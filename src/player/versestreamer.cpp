@@ -0,0 +1,218 @@
+/**
+ * @file versestreamer.cpp
+ * @brief Implementation file for VerseStreamer
+ */
+
+#include "versestreamer.h"
+#include <QDebug>
+#include <downloader/impl/recitationtask.h>
+#include <utils/recitationindex.h>
+
+VerseStreamer&
+VerseStreamer::getInstance()
+{
+  static VerseStreamer streamer;
+  return streamer;
+}
+
+VerseStreamer::VerseStreamer() {}
+
+std::optional<QString>
+VerseStreamer::fetch(int reciter, const Verse& v, bool urgent)
+{
+  RecitationTask task(reciter, v.surah(), v.number());
+  QString destination = task.destination().absoluteFilePath();
+  QString source = destination + ".part";
+
+  Stream* stream = m_streams.value(source);
+  if (!stream) {
+    stream = new Stream{ reciter, v, destination };
+    stream->state = QSharedPointer<StreamDevice::State>::create();
+    m_streams.insert(source, stream);
+    m_queue.enqueue(stream);
+  }
+
+  if (urgent)
+    start(stream);
+  else
+    startQueued();
+
+  // the partial file couldn't be created
+  if (!m_streams.contains(source))
+    return std::nullopt;
+  return source;
+}
+
+QIODevice*
+VerseStreamer::openSource(const QString& source, QObject* parent)
+{
+  Stream* stream = m_streams.value(source);
+  if (!stream)
+    return nullptr;
+
+  // the partial file is created when the download starts
+  if (!stream->file) {
+    int reciter = stream->reciter;
+    Verse verse = stream->verse;
+    if (!start(stream)) {
+      emit failed(reciter, verse);
+      return nullptr;
+    }
+  }
+
+  StreamDevice* device = new StreamDevice(source, stream->state, parent);
+  if (!device->open(QIODevice::ReadOnly)) {
+    delete device;
+    return nullptr;
+  }
+
+  stream->devices.append(device);
+  return device;
+}
+
+bool
+VerseStreamer::start(Stream* stream)
+{
+  if (stream->file)
+    return true;
+
+  m_queue.removeOne(stream);
+  stream->file = new QFile(stream->destination + ".part", this);
+  if (!stream->file->open(QIODevice::WriteOnly)) {
+    qWarning() << "Couldn't write" << stream->file->fileName();
+    discard(stream);
+    return false;
+  }
+
+  RecitationTask task(
+    stream->reciter, stream->verse.surah(), stream->verse.number());
+  m_active++;
+  stream->reply = m_netMgr.get(QNetworkRequest(task.url()));
+  connect(stream->reply, &QNetworkReply::readyRead, this, [this, stream]() {
+    received(stream);
+  });
+  connect(stream->reply, &QNetworkReply::finished, this, [this, stream]() {
+    m_active--;
+    finished(stream);
+    startQueued();
+  });
+
+  return true;
+}
+
+void
+VerseStreamer::received(Stream* stream)
+{
+  QByteArray data = stream->reply->readAll();
+  qint64 total =
+    stream->reply->header(QNetworkRequest::ContentLengthHeader).toLongLong();
+  if (stream->file->write(data) != data.size() || !stream->file->flush()) {
+    qWarning() << "Couldn't write" << stream->file->fileName();
+    stream->reply->abort();
+    return;
+  }
+
+  {
+    QMutexLocker locker(&stream->state->mutex);
+    stream->state->written += data.size();
+    if (total > 0)
+      stream->state->total = total;
+    stream->state->grown.wakeAll();
+  }
+
+  for (const QPointer<StreamDevice>& device : std::as_const(stream->devices)) {
+    if (device)
+      device->notifyGrown();
+  }
+}
+
+void
+VerseStreamer::finished(Stream* stream)
+{
+  bool ok = stream->reply && stream->reply->error() == QNetworkReply::NoError;
+  if (ok)
+    received(stream);
+
+  QString source = stream->file->fileName();
+  stream->file->close();
+  stream->file->deleteLater();
+  if (stream->reply)
+    stream->reply->deleteLater();
+
+  ok = ok && stream->file->error() == QFile::NoError;
+  {
+    QMutexLocker locker(&stream->state->mutex);
+    stream->state->done = true;
+    stream->state->failed = !ok;
+    stream->state->total = stream->state->written;
+    stream->state->grown.wakeAll();
+  }
+
+  for (const QPointer<StreamDevice>& device : std::as_const(stream->devices)) {
+    if (device)
+      device->notifyGrown();
+  }
+
+  // open devices keep reading the partial file, it is renamed unless the
+  // platform refuses to rename an open file, then it is copied and removed
+  // once the last device is closed
+  bool kept = false;
+  if (ok) {
+    QFile::remove(stream->destination);
+    kept = !QFile::rename(source, stream->destination);
+    if (kept && !QFile::copy(source, stream->destination))
+      ok = false;
+  }
+
+  if (ok) {
+    RecitationIndex::getInstance().markDownloaded(
+      stream->reciter, stream->verse.surah(), stream->verse.number());
+  } else if (!stream->cancelled) {
+    qWarning() << "Couldn't stream" << stream->destination;
+    emit failed(stream->reciter, stream->verse);
+  }
+
+  if ((kept || !ok) && !QFile::remove(source)) {
+    for (const QPointer<StreamDevice>& device :
+         std::as_const(stream->devices)) {
+      if (device)
+        connect(device, &QObject::destroyed, this, [source]() {
+          QFile::remove(source);
+        });
+    }
+  }
+
+  m_streams.remove(source);
+  delete stream;
+}
+
+void
+VerseStreamer::discard(Stream* stream)
+{
+  m_queue.removeOne(stream);
+  m_streams.remove(stream->destination + ".part");
+  delete stream->file;
+  delete stream;
+}
+
+void
+VerseStreamer::cancel()
+{
+  while (!m_queue.isEmpty())
+    discard(m_queue.head());
+
+  // aborting a reply finishes its stream right away
+  const QList<Stream*> streams = m_streams.values();
+  for (Stream* stream : streams) {
+    stream->cancelled = true;
+    if (stream->reply)
+      stream->reply->abort();
+  }
+}
+
+void
+VerseStreamer::startQueued()
+{
+  while (m_active < s_maxActive && !m_queue.isEmpty())
+    start(m_queue.dequeue());
+}
@@ -0,0 +1,131 @@
+/**
+ * @file versestreamer.h
+ * @brief Header file for the VerseStreamer class
+ */
+
+#ifndef VERSESTREAMER_H
+#define VERSESTREAMER_H
+
+#include <QFile>
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <optional>
+#include <player/streamdevice.h>
+#include <types/verse.h>
+
+/**
+ * @class VerseStreamer
+ * @brief Downloads missing verse recitations on demand while they play.
+ *
+ * A verse is downloaded from the RecitationTask url into a partial file next
+ * to its destination, every received chunk is written through to the file so
+ * playback can start from a StreamDevice before the download ends. The
+ * partial file is moved to the destination and marked in the RecitationIndex
+ * once complete. Verses needed now start downloading immediately, prefetched
+ * verses are queued behind a small number of concurrent downloads.
+ */
+class VerseStreamer : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Gets a reference to the single class instance.
+   * @return Reference to the static class instance.
+   */
+  static VerseStreamer& getInstance();
+  /**
+   * @brief Starts downloading a verse unless it is already downloading.
+   * @param reciter The index of the reciter in Reciter::reciters.
+   * @param v The verse to download.
+   * @param urgent Boolean indicating whether the verse is needed now, urgent
+   * verses skip the queue.
+   * @return QString of the partial file the verse is streamed from,
+   * std::nullopt if the partial file couldn't be created.
+   */
+  std::optional<QString> fetch(int reciter, const Verse& v, bool urgent);
+  /**
+   * @brief Opens a device reading a verse being downloaded.
+   * @param source The partial file path returned from fetch().
+   * @param parent Pointer to the parent QObject of the device.
+   * @return Pointer to the opened QIODevice, nullptr if the source is not
+   * being downloaded.
+   */
+  QIODevice* openSource(const QString& source, QObject* parent);
+  /**
+   * @brief Drops the queued verses and aborts the running downloads, their
+   * partial files are removed.
+   */
+  void cancel();
+
+signals:
+  /**
+   * @brief Emitted when a verse download fails.
+   * @param reciter The index of the reciter in Reciter::reciters.
+   * @param v The verse that couldn't be downloaded.
+   */
+  void failed(int reciter, const Verse& v);
+
+private:
+  VerseStreamer();
+  /**
+   * @brief Stream struct holds a single verse download.
+   */
+  struct Stream
+  {
+    int reciter;
+    Verse verse;
+    QString destination;
+    QFile* file = nullptr;
+    QPointer<QNetworkReply> reply;
+    QSharedPointer<StreamDevice::State> state;
+    QList<QPointer<StreamDevice>> devices;
+    bool cancelled = false;
+  };
+  /**
+   * @brief Maximum number of concurrent prefetch downloads.
+   */
+  static const int s_maxActive = 2;
+  /**
+   * @brief Starts downloading a queued stream.
+   * @param stream The stream to start.
+   * @return Boolean indicating whether the download started, the stream is
+   * discarded otherwise.
+   */
+  bool start(Stream* stream);
+  /**
+   * @brief Writes the received data of a stream through to its file.
+   * @param stream The stream that received data.
+   */
+  void received(Stream* stream);
+  /**
+   * @brief Completes or discards a stream once its download ends.
+   * @param stream The stream that finished.
+   */
+  void finished(Stream* stream);
+  /**
+   * @brief Removes a stream that didn't start downloading.
+   * @param stream The stream to remove.
+   */
+  void discard(Stream* stream);
+  /**
+   * @brief Starts queued streams while below the concurrency limit.
+   */
+  void startQueued();
+  QNetworkAccessManager m_netMgr;
+  /**
+   * @brief Streams by the path of their partial file.
+   */
+  QHash<QString, Stream*> m_streams;
+  /**
+   * @brief Prefetched streams waiting for a download slot.
+   */
+  QQueue<Stream*> m_queue;
+  int m_active = 0;
+};
+
+#endif // VERSESTREAMER_H
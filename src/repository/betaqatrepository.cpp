@@ -1,5 +1,6 @@
 #include "betaqatrepository.h"
 #include <QSqlQuery>
+#include <utils/startupreport.h>
 
 BetaqatRepository&
 BetaqatRepository::getInstance()
@@ -19,6 +20,7 @@ BetaqatRepository::BetaqatRepository()
 void
 BetaqatRepository::open()
 {
+  StartupReport::Phase phase("BetaqatRepository::open");
   setDatabaseName(m_assetsDir.absoluteFilePath("betaqat.db"));
   if (!QSqlDatabase::open())
     qFatal("Error opening betaqat db");
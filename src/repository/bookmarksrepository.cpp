@@ -2,6 +2,7 @@
 #include <QSqlError>
 #include <QSqlQuery>
 #include <service/servicefactory.h>
+#include <utils/startupreport.h>
 
 BookmarksRepository&
 BookmarksRepository::getInstance()
@@ -17,6 +18,7 @@ BookmarksRepository::BookmarksRepository()
   , m_quranService(ServiceFactory::quranService())
 {
   BookmarksRepository::open();
+  StartupReport::Phase phase("BookmarksRepository tables");
   QSqlQuery dbQuery(*this);
   dbQuery.exec(
     "CREATE TABLE IF NOT EXISTS khatmah(id INTEGER PRIMARY KEY "
@@ -34,6 +36,7 @@ BookmarksRepository::BookmarksRepository()
 void
 BookmarksRepository::open()
 {
+  StartupReport::Phase phase("BookmarksRepository::open");
   setDatabaseName(m_configDir.absoluteFilePath("bookmarks.db"));
   if (!QSqlDatabase::open())
     qFatal("Error opening bookmarks db");
@@ -1,5 +1,6 @@
 #include "glyphsrepository.h"
 #include <QSqlQuery>
+#include <utils/startupreport.h>
 
 GlyphsRepository&
 GlyphsRepository::getInstance()
@@ -12,6 +13,7 @@ GlyphsRepository::GlyphsRepository()
   : QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", "GlyphsCon"))
   , m_config(Configuration::getInstance())
   , m_assetsDir(DirManager::getInstance().assetsDir())
+  , m_fontMgr(FontManager::getInstance())
 {
     GlyphsRepository::open();
 }
@@ -19,6 +21,7 @@ GlyphsRepository::GlyphsRepository()
 void
 GlyphsRepository::open()
 {
+  StartupReport::Phase phase("GlyphsRepository::open");
   setDatabaseName(m_assetsDir.absoluteFilePath("glyphs.db"));
   if (!QSqlDatabase::open())
     qFatal("Error opening glyphs db");
@@ -36,7 +39,7 @@ GlyphsRepository::getPageLines(const int page) const
   QSqlQuery dbQuery(*this);
 
   QString query = "SELECT %0 FROM pages WHERE page_no=%1";
-  query = query.arg("qcf_v" + QString::number(m_config.qcfVersion()),
+  query = query.arg("qcf_v" + QString::number(m_fontMgr.pageQcfVersion(page)),
                     QString::number(page));
 
   dbQuery.prepare(query);
@@ -82,12 +85,14 @@ GlyphsRepository::getJuzGlyph(const int juz) const
 }
 
 QString
-GlyphsRepository::getVerseGlyphs(const int sIdx, const int vIdx) const
+GlyphsRepository::getVerseGlyphs(const int sIdx,
+                                 const int vIdx,
+                                 const int page) const
 {
   QSqlQuery dbQuery(*this);
 
   QString query = "SELECT %0 FROM ayah_glyphs WHERE surah=%1 AND ayah=%2";
-  query = query.arg("qcf_v" + QString::number(m_config.qcfVersion()),
+  query = query.arg("qcf_v" + QString::number(m_fontMgr.pageQcfVersion(page)),
                     QString::number(sIdx),
                     QString::number(vIdx));
 
@@ -99,3 +104,59 @@ GlyphsRepository::getVerseGlyphs(const int sIdx, const int vIdx) const
 
   return dbQuery.value(0).toString();
 }
+
+QList<QPair<int, int>>
+GlyphsRepository::getVerseCoordinates(const int page) const
+{
+  QString table =
+    "coordinates_v" + QString::number(m_fontMgr.pageQcfVersion(page));
+  if (!tables().contains(table))
+    return generateVerseCoordinates(getPageLines(page));
+
+  QSqlQuery dbQuery(*this);
+  dbQuery.prepare("SELECT start_pos,end_pos FROM " + table +
+                  " WHERE page=:p ORDER BY surah,ayah");
+  dbQuery.bindValue(0, page);
+  if (!dbQuery.exec()) {
+    qCritical()
+      << "Error occurred during getVerseCoordinates SQL statment exec";
+    return generateVerseCoordinates(getPageLines(page));
+  }
+
+  QList<QPair<int, int>> coordinates;
+  while (dbQuery.next())
+    coordinates.append({ dbQuery.value(0).toInt(), dbQuery.value(1).toInt() });
+
+  return coordinates;
+}
+
+QList<QPair<int, int>>
+GlyphsRepository::generateVerseCoordinates(const QStringList& lines)
+{
+  QList<QPair<int, int>> coordinates;
+  int pos = 0, start = 0;
+  foreach (QString l, lines) {
+    l = l.trimmed();
+    if (l.isEmpty())
+      continue;
+
+    // surah frames & basmallah are a block separator + a single image
+    if (l.contains("frame") || l.contains("bsml")) {
+      pos += 2;
+      start += 2;
+      continue;
+    }
+
+    pos++; // block separator
+    foreach (QChar glyph, l) {
+      if (glyph != ':') {
+        pos++;
+      } else {
+        coordinates.append({ start, pos });
+        start = pos;
+      }
+    }
+  }
+
+  return coordinates;
+}
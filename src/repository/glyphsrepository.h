@@ -7,6 +7,7 @@
 #include <repository/dbconnection.h>
 #include <utils/configuration.h>
 #include <utils/dirmanager.h>
+#include <utils/fontmanager.h>
 
 /**
  * @class GlyphsRepository
@@ -60,9 +61,21 @@ public:
    * @brief Retrieves the glyphs for a specific verse.
    * @param sIdx The surah index of the verse.
    * @param vIdx The verse index of the verse.
+   * @param page The page of the verse, used to match the page font version.
    * @return QString containing the glyphs for the specified verse.
    */
-  QString getVerseGlyphs(const int sIdx, const int vIdx) const;
+  QString getVerseGlyphs(const int sIdx, const int vIdx, const int page) const;
+  /**
+   * @brief Retrieves the start & end positions of each verse in a page.
+   *
+   * Positions are relative to the start of the page body (after the header)
+   * and follow the order of verses in the page. They are loaded from the
+   * `coordinates_vN` table when it exists, otherwise generated from the page
+   * lines.
+   * @param page The page number to retrieve verse coordinates for.
+   * @return QList of [start, end) document positions for each verse.
+   */
+  QList<QPair<int, int>> getVerseCoordinates(const int page) const;
 
 private:
   /**
@@ -72,6 +85,14 @@ private:
    * connection.
    */
   GlyphsRepository();
+  /**
+   * @brief Generates the verse coordinates of a page by walking its lines the
+   * same way QuranPageBrowser inserts them in the page document.
+   * @param lines - QStringList of page lines
+   * @return QList of [start, end) positions for each verse in the page.
+   */
+  static QList<QPair<int, int>> generateVerseCoordinates(
+    const QStringList& lines);
   /**
    * @brief Reference to the singleton Configuration instance.
    */
@@ -80,6 +101,11 @@ private:
    * @brief Reference to the application assets directory.
    */
   const QDir& m_assetsDir;
+  /**
+   * @brief Reference to the singleton FontManager instance, used to get the
+   * QCF version of each page.
+   */
+  FontManager& m_fontMgr;
 };
 
 #endif // GLYPHSREPOSITORY_H
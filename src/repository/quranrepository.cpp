@@ -1,6 +1,7 @@
 #include "quranrepository.h"
 #include <QRandomGenerator>
 #include <QSqlError>
+#include <utils/startupreport.h>
 
 QuranRepository&
 QuranRepository::getInstance()
@@ -15,6 +16,7 @@ QuranRepository::QuranRepository()
   , m_config(Configuration::getInstance())
 {
   QuranRepository::open();
+  StartupReport::Phase phase("QuranRepository surah names");
   for (int i = 1; i <= 114; i++)
     m_surahNames.append(surahName(i));
 }
@@ -31,6 +33,7 @@ QuranRepository::executeQuery(QSqlQuery& query, QString errMsg) const
 void
 QuranRepository::open()
 {
+  StartupReport::Phase phase("QuranRepository::open");
   setDatabaseName(m_assetsDir.absoluteFilePath("quran.db"));
   if (!QSqlDatabase::open())
     qFatal("Error opening quran db");
@@ -187,6 +190,55 @@ QuranRepository::verseText(const int sIdx, const int vIdx) const
   return dbQuery.value(0).toString();
 }
 
+QList<int>
+QuranRepository::versePages() const
+{
+  QList<int> pages;
+  QSqlQuery dbQuery(*this);
+  dbQuery.setForwardOnly(true);
+  dbQuery.prepare("SELECT page FROM verses_v1 ORDER BY id");
+
+  executeQuery(dbQuery, "Error occurred during versePages SQL statment exec");
+
+  pages.reserve(6236);
+  while (dbQuery.next())
+    pages.append(dbQuery.value(0).toInt());
+
+  return pages;
+}
+
+QList<QPair<Verse, QString>>
+QuranRepository::verseTextRange(const int sIdx,
+                                const int firstVerse,
+                                const int lastVerse) const
+{
+  QList<QPair<Verse, QString>> verses;
+  QSqlQuery dbQuery(*this);
+  dbQuery.setForwardOnly(true);
+  QString column = m_config.verseType() == Configuration::Annotated
+                     ? "aya_text_annotated"
+                     : "aya_text";
+  dbQuery.prepare("SELECT page,aya_no," + column + " FROM verses_v" +
+                  QString::number(m_config.qcfVersion()) +
+                  " WHERE sura_no=? AND aya_no BETWEEN ? AND ? "
+                  "ORDER BY aya_no");
+  dbQuery.addBindValue(sIdx);
+  dbQuery.addBindValue(firstVerse);
+  dbQuery.addBindValue(lastVerse);
+
+  executeQuery(dbQuery,
+               "Error occurred during verseTextRange SQL statment exec");
+
+  verses.reserve(lastVerse - firstVerse + 1);
+  while (dbQuery.next()) {
+    verses.append(
+      { Verse(dbQuery.value(0).toInt(), sIdx, dbQuery.value(1).toInt()),
+        dbQuery.value(2).toString() });
+  }
+
+  return verses;
+}
+
 int
 QuranRepository::surahStartPage(int surahIdx) const
 {
@@ -89,6 +89,21 @@ public:
    * @return The text of the specified verse.
    */
   QString verseText(const int sIdx, const int vIdx) const;
+  /**
+   * @brief Get the page of every verse in a single query.
+   * @return The verse pages indexed by the verse id - 1.
+   */
+  QList<int> versePages() const;
+  /**
+   * @brief Get the verses in a range of a surah along with their text.
+   * @param sIdx The surah index of the verses.
+   * @param firstVerse The first verse number.
+   * @param lastVerse The last verse number.
+   * @return The verses ordered by verse number, paired with their text.
+   */
+  QList<QPair<Verse, QString>> verseTextRange(const int sIdx,
+                                              const int firstVerse,
+                                              const int lastVerse) const;
   /**
    * @brief Get the starting page of a specific surah.
    * @param surahIdx The surah index.
@@ -1,6 +1,7 @@
 #include "tafsirrepository.h"
 #include <QSqlQuery>
 #include <types/tafsir.h>
+#include <utils/startupreport.h>
 
 TafsirRepository&
 TafsirRepository::getInstance()
@@ -15,12 +16,14 @@ TafsirRepository::TafsirRepository()
   , m_dirMgr(DirManager::getInstance())
   , m_tafasir(Tafsir::tafasir)
 {
+  Tafsir::populateTafasir();
   loadTafsir();
 }
 
 void
 TafsirRepository::open()
 {
+  StartupReport::Phase phase("TafsirRepository::open");
   setDatabaseName(m_tafsirFile.absoluteFilePath());
   if (!QSqlDatabase::open())
     qFatal("Error opening tafsir db");
@@ -82,6 +85,30 @@ TafsirRepository::getTafsir(const int sIdx, const int vIdx)
   return dbQuery.value(0).toString();
 }
 
+QStringList
+TafsirRepository::getTafsirRange(const int sIdx,
+                                 const int firstVerse,
+                                 const int lastVerse)
+{
+  QStringList texts(lastVerse - firstVerse + 1);
+  QSqlQuery dbQuery(*this);
+  dbQuery.setForwardOnly(true);
+
+  dbQuery.prepare("SELECT aya,text FROM content WHERE sura=? AND aya BETWEEN "
+                  "? AND ?");
+  dbQuery.addBindValue(sIdx);
+  dbQuery.addBindValue(firstVerse);
+  dbQuery.addBindValue(lastVerse);
+
+  if (!dbQuery.exec())
+    qCritical("Couldn't execute getTafsirRange query!");
+
+  while (dbQuery.next())
+    texts[dbQuery.value(0).toInt() - firstVerse] = dbQuery.value(1).toString();
+
+  return texts;
+}
+
 std::optional<const Tafsir>
 TafsirRepository::currTafsir() const
 {
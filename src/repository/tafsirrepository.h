@@ -59,6 +59,16 @@ public:
    * @return The text of the specified verse in the current tafsir.
    */
   QString getTafsir(const int sIdx, const int vIdx);
+  /**
+   * @brief Get the tafsir text for a range of verses in a surah.
+   * @param sIdx The index of the surah.
+   * @param firstVerse The index of the first verse.
+   * @param lastVerse The index of the last verse.
+   * @return The text of each verse in the range in the current tafsir.
+   */
+  QStringList getTafsirRange(const int sIdx,
+                             const int firstVerse,
+                             const int lastVerse);
   /**
    * @brief Get the currently selected tafsir.
    * @return An optional containing the current tafsir if set; otherwise, an
@@ -1,5 +1,6 @@
 #include "translationrepository.h"
 #include <QSqlQuery>
+#include <utils/startupreport.h>
 
 TranslationRepository&
 TranslationRepository::getInstance()
@@ -19,6 +20,7 @@ TranslationRepository::TranslationRepository()
 void
 TranslationRepository::open()
 {
+  StartupReport::Phase phase("TranslationRepository::open");
   setDatabaseName(m_translationFile.absoluteFilePath());
   if (!QSqlDatabase::open())
     qFatal("Error opening translation db");
@@ -81,6 +83,30 @@ TranslationRepository::getTranslation(const int sIdx, const int vIdx) const
   return dbQuery.value(0).toString();
 }
 
+QStringList
+TranslationRepository::getTranslationRange(const int sIdx,
+                                           const int firstVerse,
+                                           const int lastVerse) const
+{
+  QStringList texts(lastVerse - firstVerse + 1);
+  QSqlQuery dbQuery(*this);
+  dbQuery.setForwardOnly(true);
+
+  dbQuery.prepare("SELECT aya,text FROM content WHERE sura=? AND aya BETWEEN "
+                  "? AND ?");
+  dbQuery.addBindValue(sIdx);
+  dbQuery.addBindValue(firstVerse);
+  dbQuery.addBindValue(lastVerse);
+
+  if (!dbQuery.exec())
+    qCritical("Couldn't execute getTranslationRange query!");
+
+  while (dbQuery.next())
+    texts[dbQuery.value(0).toInt() - firstVerse] = dbQuery.value(1).toString();
+
+  return texts;
+}
+
 std::optional<const ::Translation>
 TranslationRepository::currTranslation() const
 {
@@ -63,6 +63,16 @@ public:
    * @return The translation text for the specified surah and ayah.
    */
   QString getTranslation(const int sIdx, const int vIdx) const;
+  /**
+   * @brief Retrieves the translation text for a range of ayat in a surah.
+   * @param sIdx Index of the surah.
+   * @param firstVerse Index of the first ayah.
+   * @param lastVerse Index of the last ayah.
+   * @return The translation text of each ayah in the range, in order.
+   */
+  QStringList getTranslationRange(const int sIdx,
+                                  const int firstVerse,
+                                  const int lastVerse) const;
   /**
    * @brief Gets the currently selected translation.
    * @return An optional containing the current translation, or an empty
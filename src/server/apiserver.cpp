@@ -0,0 +1,139 @@
+/**
+ * @file apiserver.cpp
+ * @brief Implementation file for ApiServer
+ */
+
+#include "apiserver.h"
+#include "apiworker.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <algorithm>
+#include <types/tafsir.h>
+#include <types/translation.h>
+#include <utils/configuration.h>
+
+ApiServer::ApiServer(int workers, int cacheSize, QObject* parent)
+  : QTcpServer(parent)
+  , m_workerCount(workers > 0 ? workers
+                              : std::clamp(QThread::idealThreadCount(), 1, 8))
+  , m_cache(cacheSize)
+{
+}
+
+ApiServer::~ApiServer()
+{
+  stop();
+}
+
+bool
+ApiServer::start(quint16 port, const QHostAddress& address)
+{
+  Tafsir::populateTafasir();
+  Translation::populateTranslations();
+  buildCatalog();
+
+  int qcf = Configuration::getInstance().qcfVersion();
+  for (int i = 0; i < m_workerCount; i++) {
+    QThread* thread = new QThread(this);
+    thread->setObjectName("ApiWorker-" + QString::number(i));
+    ApiWorker* worker = new ApiWorker(i, qcf, this);
+    worker->moveToThread(thread);
+    connect(thread, &QThread::finished, worker, &QObject::deleteLater);
+    thread->start();
+    m_threads.append(thread);
+    m_workers.append(worker);
+  }
+
+  if (!listen(address, port)) {
+    qCritical() << "API server couldn't listen on" << address << port
+                << errorString();
+    stop();
+    return false;
+  }
+
+  qInfo() << "API server listening on" << serverAddress() << serverPort()
+          << "with" << m_workerCount << "workers";
+  return true;
+}
+
+void
+ApiServer::stop()
+{
+  close();
+  for (QThread* thread : std::as_const(m_threads)) {
+    thread->quit();
+    thread->wait();
+  }
+
+  qDeleteAll(m_threads);
+  m_threads.clear();
+  m_workers.clear();
+}
+
+void
+ApiServer::incomingConnection(qintptr socketDescriptor)
+{
+  // the socket is created in the worker thread from the descriptor
+  ApiWorker* worker = m_workers.at(m_next);
+  m_next = (m_next + 1) % m_workers.size();
+  QMetaObject::invokeMethod(
+    worker,
+    [worker, socketDescriptor]() {
+      worker->handleConnection(socketDescriptor);
+    },
+    Qt::QueuedConnection);
+}
+
+std::optional<QByteArray>
+ApiServer::cached(const QString& key)
+{
+  QMutexLocker locker(&m_cacheMutex);
+  QByteArray* body = m_cache.object(key);
+  if (!body)
+    return std::nullopt;
+
+  return *body;
+}
+
+void
+ApiServer::cache(const QString& key, const QByteArray& body)
+{
+  QMutexLocker locker(&m_cacheMutex);
+  m_cache.insert(key, new QByteArray(body));
+}
+
+const QByteArray&
+ApiServer::catalog() const
+{
+  return m_catalog;
+}
+
+void
+ApiServer::buildCatalog()
+{
+  QJsonArray translations;
+  for (const Translation& t : std::as_const(Translation::translations)) {
+    QJsonObject obj;
+    obj["id"] = t.id();
+    obj["name"] = t.displayName();
+    obj["available"] = t.isAvailable();
+    translations.append(obj);
+  }
+
+  QJsonArray tafasir;
+  for (const Tafsir& t : std::as_const(Tafsir::tafasir)) {
+    QJsonObject obj;
+    obj["id"] = t.id();
+    obj["name"] = t.displayName();
+    obj["text"] = t.isText();
+    obj["available"] = t.isAvailable();
+    tafasir.append(obj);
+  }
+
+  QJsonObject catalog;
+  catalog["translations"] = translations;
+  catalog["tafasir"] = tafasir;
+  m_catalog = QJsonDocument(catalog).toJson(QJsonDocument::Compact);
+}
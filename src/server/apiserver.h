@@ -0,0 +1,105 @@
+/**
+ * @file apiserver.h
+ * @brief Header file for ApiServer
+ */
+
+#ifndef APISERVER_H
+#define APISERVER_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QHostAddress>
+#include <QList>
+#include <QMutex>
+#include <QTcpServer>
+#include <QThread>
+#include <optional>
+
+class ApiWorker;
+
+/**
+ * @brief ApiServer class serves verse, translation and tafsir lookups as JSON
+ * over a local HTTP/1.1 API
+ * @details accepted connections are handed round-robin to a fixed pool of
+ * ApiWorker threads, each with its own database connections. Connections are
+ * kept alive between requests and successful responses are shared between the
+ * workers through a LRU response cache. Endpoints:
+ * - /api/verse?surah=&verse=
+ * - /api/glyphs?surah=&verse=[&qcf=]
+ * - /api/translation?id=&surah=&verse=
+ * - /api/tafsir?id=&surah=&verse=
+ * - /api/search?text=[&whole=1][&limit=]
+ * - /api/page?page=
+ * - /api/catalog
+ */
+class ApiServer : public QTcpServer
+{
+  Q_OBJECT
+public:
+  /**
+   * @brief class constructor
+   * @param workers - number of worker threads, 0 for the ideal thread count
+   * @param cacheSize - maximum number of cached responses, 0 to disable the
+   * cache
+   * @param parent - pointer to parent QObject
+   */
+  explicit ApiServer(int workers = 0,
+                     int cacheSize = 4096,
+                     QObject* parent = nullptr);
+  ~ApiServer();
+  /**
+   * @brief start the worker threads and listen for connections
+   * @param port - TCP port to listen on
+   * @param address - address to listen on, the loopback address by default
+   * @return boolean indicating whether the server is listening
+   */
+  bool start(quint16 port,
+             const QHostAddress& address = QHostAddress::LocalHost);
+  /**
+   * @brief stop listening and stop the worker threads
+   */
+  void stop();
+  /**
+   * @brief lookup a cached response body, called from worker threads
+   * @param key - request target
+   * @return QByteArray of the cached body, std::nullopt if not cached
+   */
+  std::optional<QByteArray> cached(const QString& key);
+  /**
+   * @brief cache a response body, called from worker threads
+   * @param key - request target
+   * @param body - response body
+   */
+  void cache(const QString& key, const QByteArray& body);
+  /**
+   * @brief getter for m_catalog
+   * @return QByteArray of the catalog response body
+   */
+  const QByteArray& catalog() const;
+
+protected:
+  void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+  /**
+   * @brief build the catalog of translations and tafasir in the GUI thread,
+   * the catalogs and their availability are not safe to read from the workers
+   */
+  void buildCatalog();
+  const int m_workerCount;
+  QList<QThread*> m_threads;
+  QList<ApiWorker*> m_workers;
+  /**
+   * @brief index of the worker receiving the next connection
+   */
+  int m_next = 0;
+  /**
+   * @brief response bodies by request target, QCache evicts the least
+   * recently used responses
+   */
+  QCache<QString, QByteArray> m_cache;
+  QMutex m_cacheMutex;
+  QByteArray m_catalog;
+};
+
+#endif // APISERVER_H
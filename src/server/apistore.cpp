@@ -0,0 +1,241 @@
+/**
+ * @file apistore.cpp
+ * @brief Implementation file for ApiStore
+ */
+
+#include "apistore.h"
+#include <QFileInfo>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <types/tafsir.h>
+#include <types/translation.h>
+#include <utils/dirmanager.h>
+
+ApiStore::ApiStore(const QString& name, int qcfVersion)
+  : m_name(name)
+  , m_versesTable("verses_v" + QString::number(qcfVersion))
+{
+  const QDir& assets = DirManager::getInstance().assetsDir();
+  m_quranDb = openDb("quran", assets.absoluteFilePath("quran.db"));
+  m_glyphsDb = openDb("glyphs", assets.absoluteFilePath("glyphs.db"));
+}
+
+ApiStore::~ApiStore()
+{
+  QStringList names{ m_quranDb.connectionName(), m_glyphsDb.connectionName() };
+  for (const QSqlDatabase& db : m_contentDbs)
+    names.append(db.connectionName());
+
+  // connections can only be removed once no QSqlDatabase refers to them
+  m_quranDb = QSqlDatabase();
+  m_glyphsDb = QSqlDatabase();
+  m_contentDbs.clear();
+  for (const QString& name : names)
+    QSqlDatabase::removeDatabase(name);
+}
+
+QSqlDatabase
+ApiStore::openDb(const QString& suffix, const QString& path)
+{
+  QSqlDatabase db =
+    QSqlDatabase::addDatabase("QSQLITE", m_name + '-' + suffix);
+  db.setDatabaseName(path);
+  db.setConnectOptions("QSQLITE_OPEN_READONLY");
+  if (!db.open())
+    qCritical() << "Couldn't open" << path << db.lastError().text();
+
+  return db;
+}
+
+std::optional<QSqlDatabase>
+ApiStore::contentDb(const QString& dir, const QString& id)
+{
+  QString key = dir + '/' + id;
+  auto it = m_contentDbs.constFind(key);
+  if (it != m_contentDbs.cend())
+    return it.value();
+
+  std::optional<QString> filename;
+  bool isExtra = false;
+  if (dir == "translations") {
+    std::optional<Translation> t = Translation::findById(id);
+    if (t.has_value()) {
+      filename = t->filename();
+      isExtra = t->isExtra();
+    }
+  } else {
+    std::optional<Tafsir> t = Tafsir::findById(id);
+    if (t.has_value()) {
+      filename = t->filename();
+      isExtra = t->isExtra();
+    }
+  }
+
+  if (!filename.has_value())
+    return std::nullopt;
+
+  const QDir& base = isExtra ? DirManager::getInstance().downloadsDir()
+                             : DirManager::getInstance().assetsDir();
+  QString path = base.absoluteFilePath(dir + '/' + filename.value());
+  if (!QFileInfo::exists(path))
+    return std::nullopt;
+
+  QSqlDatabase db = openDb(key, path);
+  if (!db.isOpen())
+    return std::nullopt;
+
+  m_contentDbs.insert(key, db);
+  return db;
+}
+
+std::optional<QJsonObject>
+ApiStore::verse(int surah, int verse)
+{
+  QSqlQuery query(m_quranDb);
+  query.prepare("SELECT page,jozz,aya_text,aya_text_annotated,aya_text_emlaey "
+                "FROM " +
+                m_versesTable + " WHERE sura_no=? AND aya_no=?");
+  query.addBindValue(surah);
+  query.addBindValue(verse);
+  if (!query.exec() || !query.next())
+    return std::nullopt;
+
+  QJsonObject obj;
+  obj["surah"] = surah;
+  obj["verse"] = verse;
+  obj["page"] = query.value(0).toInt();
+  obj["juz"] = query.value(1).toInt();
+  obj["text"] = query.value(2).toString();
+  obj["annotated"] = query.value(3).toString();
+  obj["plain"] = query.value(4).toString();
+  return obj;
+}
+
+std::optional<QJsonObject>
+ApiStore::glyphs(int surah, int verse, int qcf)
+{
+  QSqlQuery query(m_glyphsDb);
+  query.prepare("SELECT qcf_v" + QString::number(qcf) +
+                " FROM ayah_glyphs WHERE surah=? AND ayah=?");
+  query.addBindValue(surah);
+  query.addBindValue(verse);
+  if (!query.exec() || !query.next())
+    return std::nullopt;
+
+  QJsonObject obj;
+  obj["surah"] = surah;
+  obj["verse"] = verse;
+  obj["qcf"] = qcf;
+  obj["glyphs"] = query.value(0).toString();
+  return obj;
+}
+
+std::optional<QJsonObject>
+ApiStore::translation(const QString& id, int surah, int verse)
+{
+  std::optional<QSqlDatabase> db = contentDb("translations", id);
+  if (!db.has_value())
+    return std::nullopt;
+
+  QSqlQuery query(db.value());
+  query.prepare("SELECT text FROM content WHERE sura=? AND aya=?");
+  query.addBindValue(surah);
+  query.addBindValue(verse);
+  if (!query.exec())
+    return std::nullopt;
+
+  QJsonObject obj;
+  obj["id"] = id;
+  obj["surah"] = surah;
+  obj["verse"] = verse;
+  obj["text"] = query.next() ? query.value(0).toString() : QString();
+  return obj;
+}
+
+std::optional<QJsonObject>
+ApiStore::tafsir(const QString& id, int surah, int verse)
+{
+  std::optional<QSqlDatabase> db = contentDb("tafasir", id);
+  if (!db.has_value())
+    return std::nullopt;
+
+  QSqlQuery query(db.value());
+  query.prepare("SELECT text FROM content WHERE sura=? AND aya=?");
+  query.addBindValue(surah);
+  query.addBindValue(verse);
+  if (!query.exec())
+    return std::nullopt;
+
+  QJsonObject obj;
+  obj["id"] = id;
+  obj["surah"] = surah;
+  obj["verse"] = verse;
+  obj["text"] = query.next() ? query.value(0).toString() : QString();
+  return obj;
+}
+
+QJsonArray
+ApiStore::search(const QString& text, bool wholeWord, int limit)
+{
+  QSqlQuery query(m_quranDb);
+  query.setForwardOnly(true);
+  QString condition = wholeWord
+                        ? "(aya_text_emlaey LIKE ? OR aya_text_emlaey LIKE ?)"
+                        : "aya_text_emlaey LIKE ?";
+  query.prepare("SELECT page,sura_no,aya_no,aya_text FROM " + m_versesTable +
+                " WHERE " + condition + " ORDER BY id LIMIT ?");
+  if (wholeWord) {
+    query.addBindValue(text + " %");
+    query.addBindValue("% " + text + " %");
+  } else {
+    query.addBindValue('%' + text + '%');
+  }
+  query.addBindValue(limit);
+
+  QJsonArray results;
+  if (!query.exec())
+    return results;
+
+  while (query.next()) {
+    QJsonObject obj;
+    obj["page"] = query.value(0).toInt();
+    obj["surah"] = query.value(1).toInt();
+    obj["verse"] = query.value(2).toInt();
+    obj["text"] = query.value(3).toString();
+    results.append(obj);
+  }
+
+  return results;
+}
+
+std::optional<QJsonObject>
+ApiStore::page(int page)
+{
+  QSqlQuery query(m_quranDb);
+  query.setForwardOnly(true);
+  query.prepare("SELECT sura_no,aya_no,jozz FROM " + m_versesTable +
+                " WHERE page=? ORDER BY id");
+  query.addBindValue(page);
+  if (!query.exec())
+    return std::nullopt;
+
+  QJsonArray verses;
+  int juz = 0;
+  while (query.next()) {
+    QJsonObject v;
+    v["surah"] = query.value(0).toInt();
+    v["verse"] = query.value(1).toInt();
+    verses.append(v);
+    juz = juz ? juz : query.value(2).toInt();
+  }
+
+  if (verses.isEmpty())
+    return std::nullopt;
+
+  QJsonObject obj;
+  obj["page"] = page;
+  obj["juz"] = juz;
+  obj["surah"] = verses.first()["surah"];
+  obj["verses"] = verses;
+  return obj;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file apistore.h
+ * @brief Header file for ApiStore
+ */
+
+#ifndef APISTORE_H
+#define APISTORE_H
+
+#include <QDir>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSqlDatabase>
+#include <QString>
+#include <optional>
+
+/**
+ * @brief ApiStore class runs the ApiServer lookups on SQLite connections
+ * owned by a single worker thread
+ * @details the repositories hold connections bound to the GUI thread, so
+ * each ApiWorker keeps its own read-only connections to the Quran and glyphs
+ * databases and opens a connection for each requested translation & tafsir
+ * on first use. The store must be created, used and destroyed in the worker
+ * thread
+ */
+class ApiStore
+{
+public:
+  /**
+   * @brief class constructor
+   * @param name - unique name of the store used as a connection name prefix
+   * @param qcfVersion - QCF version the page numbers are reported for
+   */
+  ApiStore(const QString& name, int qcfVersion);
+  ~ApiStore();
+  /**
+   * @brief lookup a verse
+   * @param surah - surah number
+   * @param verse - verse number
+   * @return QJsonObject of the verse text, page and juz
+   */
+  std::optional<QJsonObject> verse(int surah, int verse);
+  /**
+   * @brief lookup the QCF glyphs of a verse
+   * @param surah - surah number
+   * @param verse - verse number
+   * @param qcf - QCF version (1 or 2)
+   * @return QJsonObject of the verse glyphs
+   */
+  std::optional<QJsonObject> glyphs(int surah, int verse, int qcf);
+  /**
+   * @brief lookup the translation of a verse
+   * @param id - translation id
+   * @param surah - surah number
+   * @param verse - verse number
+   * @return QJsonObject of the verse translation, std::nullopt if the
+   * translation is not available
+   */
+  std::optional<QJsonObject> translation(const QString& id,
+                                         int surah,
+                                         int verse);
+  /**
+   * @brief lookup the tafsir of a verse
+   * @param id - tafsir id
+   * @param surah - surah number
+   * @param verse - verse number
+   * @return QJsonObject of the verse tafsir, std::nullopt if the tafsir is not
+   * available
+   */
+  std::optional<QJsonObject> tafsir(const QString& id, int surah, int verse);
+  /**
+   * @brief search the verses for the given text
+   * @param text - text to search for
+   * @param wholeWord - boolean indicating whether to match whole words only
+   * @param limit - maximum number of results
+   * @return QJsonArray of the matching verses
+   */
+  QJsonArray search(const QString& text, bool wholeWord, int limit);
+  /**
+   * @brief lookup the page metadata
+   * @param page - page number
+   * @return QJsonObject of the page juz and verses
+   */
+  std::optional<QJsonObject> page(int page);
+
+private:
+  /**
+   * @brief open a read-only SQLite connection in the current thread
+   * @param suffix - connection name suffix
+   * @param path - database file path
+   * @return QSqlDatabase of the opened connection, invalid if not opened
+   */
+  QSqlDatabase openDb(const QString& suffix, const QString& path);
+  /**
+   * @brief get the connection of a content database, opened on first use
+   * @param dir - content directory (translations or tafasir)
+   * @param id - content id
+   * @return QSqlDatabase of the connection, std::nullopt if the content is
+   * not available
+   */
+  std::optional<QSqlDatabase> contentDb(const QString& dir, const QString& id);
+  const QString m_name;
+  const QString m_versesTable;
+  QSqlDatabase m_quranDb;
+  QSqlDatabase m_glyphsDb;
+  /**
+   * @brief content connections by directory & id
+   */
+  QHash<QString, QSqlDatabase> m_contentDbs;
+};
+
+#endif // APISTORE_H
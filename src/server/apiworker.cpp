@@ -0,0 +1,224 @@
+/**
+ * @file apiworker.cpp
+ * @brief Implementation file for ApiWorker
+ */
+
+#include "apiworker.h"
+#include "apiserver.h"
+#include <QJsonDocument>
+#include <QTimer>
+#include <QUrl>
+#include <algorithm>
+#include <types/verse.h>
+
+ApiWorker::ApiWorker(int index, int qcfVersion, ApiServer* server)
+  : QObject()
+  , m_index(index)
+  , m_qcfVersion(qcfVersion)
+  , m_server(server)
+{
+}
+
+ApiWorker::~ApiWorker() = default;
+
+void
+ApiWorker::handleConnection(qintptr socketDescriptor)
+{
+  QTcpSocket* socket = new QTcpSocket(this);
+  if (!socket->setSocketDescriptor(socketDescriptor)) {
+    qWarning() << "API worker couldn't accept connection"
+               << socket->errorString();
+    delete socket;
+    return;
+  }
+
+  QTimer* idle = new QTimer(socket);
+  idle->setSingleShot(true);
+  idle->setInterval(s_idleTimeout);
+  connect(idle, &QTimer::timeout, socket, &QTcpSocket::disconnectFromHost);
+  idle->start();
+
+  connect(socket, &QTcpSocket::readyRead, this, [this, socket, idle]() {
+    idle->start();
+    readRequests(socket);
+  });
+  connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+}
+
+void
+ApiWorker::readRequests(QTcpSocket* socket)
+{
+  QByteArray buffer = socket->property("buffer").toByteArray();
+  buffer.append(socket->readAll());
+
+  while (socket->state() == QAbstractSocket::ConnectedState) {
+    qsizetype end = buffer.indexOf("\r\n\r\n");
+    if (end == -1) {
+      if (buffer.size() > s_maxHeaderSize) {
+        respond(socket, error(431, "request header too large"), false);
+        return;
+      }
+      break;
+    }
+
+    QList<QByteArray> lines = buffer.left(end).split('\n');
+    buffer.remove(0, end + 4);
+
+    QList<QByteArray> requestLine = lines.takeFirst().trimmed().split(' ');
+    if (requestLine.size() != 3 || !requestLine[2].startsWith("HTTP/1.")) {
+      respond(socket, error(400, "malformed request line"), false);
+      return;
+    }
+
+    // HTTP/1.1 connections are persistent unless closed by the client
+    bool keepAlive = requestLine[2] == "HTTP/1.1";
+    qsizetype contentLength = 0;
+    for (const QByteArray& line : std::as_const(lines)) {
+      qsizetype colon = line.indexOf(':');
+      QByteArray name = line.left(colon).trimmed().toLower();
+      QByteArray value = line.mid(colon + 1).trimmed().toLower();
+      if (name == "connection")
+        keepAlive = value == "keep-alive" || (keepAlive && value != "close");
+      else if (name == "content-length")
+        contentLength = value.toLongLong();
+    }
+
+    if (requestLine[0] != "GET" || contentLength > 0) {
+      respond(socket, error(405, "only GET requests are supported"), false);
+      return;
+    }
+
+    bool cacheHit = false;
+    Response response = route(QString::fromUtf8(requestLine[1]), cacheHit);
+    respond(socket, response, keepAlive, cacheHit);
+  }
+
+  socket->setProperty("buffer", buffer);
+}
+
+ApiWorker::Response
+ApiWorker::route(const QString& target, bool& cacheHit)
+{
+  QUrl url(target);
+  QString path = url.path();
+  if (path == "/api/catalog")
+    return { 200, m_server->catalog() };
+
+  std::optional<QByteArray> cached = m_server->cached(target);
+  if (cached.has_value()) {
+    cacheHit = true;
+    return { 200, cached.value() };
+  }
+
+  if (!m_store)
+    m_store = std::make_unique<ApiStore>(
+      "ApiWorker" + QString::number(m_index), m_qcfVersion);
+
+  Response response = lookup(path, QUrlQuery(url));
+  if (response.status == 200)
+    m_server->cache(target, response.body);
+
+  return response;
+}
+
+ApiWorker::Response
+ApiWorker::lookup(const QString& path, const QUrlQuery& query)
+{
+  auto toJson = [](const QJsonObject& obj) -> Response {
+    return { 200, QJsonDocument(obj).toJson(QJsonDocument::Compact) };
+  };
+
+  if (path == "/api/search") {
+    QString text = query.queryItemValue("text", QUrl::FullyDecoded);
+    if (text.isEmpty())
+      return error(400, "missing search text");
+
+    int limit = query.queryItemValue("limit").toInt();
+    limit = limit > 0 ? std::min(limit, 1000) : 100;
+    QJsonArray results =
+      m_store->search(text, query.queryItemValue("whole") == "1", limit);
+    return { 200, QJsonDocument(results).toJson(QJsonDocument::Compact) };
+  }
+
+  if (path == "/api/page") {
+    int page = query.queryItemValue("page").toInt();
+    if (page < 1 || page > 604)
+      return error(400, "invalid page");
+
+    std::optional<QJsonObject> result = m_store->page(page);
+    return result.has_value() ? toJson(result.value())
+                              : error(500, "lookup failed");
+  }
+
+  static const QStringList verseEndpoints{
+    "/api/verse", "/api/glyphs", "/api/translation", "/api/tafsir"
+  };
+  if (!verseEndpoints.contains(path))
+    return error(404, "unknown endpoint: " + path);
+
+  int surah = query.queryItemValue("surah").toInt();
+  int verse = query.queryItemValue("verse").toInt();
+  if (verse < 1 || verse > Verse::surahVerseCount(surah))
+    return error(400, "invalid verse");
+
+  std::optional<QJsonObject> result;
+  if (path == "/api/verse") {
+    result = m_store->verse(surah, verse);
+  } else if (path == "/api/glyphs") {
+    int qcf = query.hasQueryItem("qcf") ? query.queryItemValue("qcf").toInt()
+                                        : m_qcfVersion;
+    if (qcf != 1 && qcf != 2)
+      return error(400, "invalid qcf version");
+    result = m_store->glyphs(surah, verse, qcf);
+  } else {
+    QString id = query.queryItemValue("id");
+    result = path == "/api/translation" ? m_store->translation(id, surah, verse)
+                                        : m_store->tafsir(id, surah, verse);
+    if (!result.has_value())
+      return error(404, "content not available: " + id);
+  }
+
+  if (!result.has_value())
+    return error(500, "lookup failed");
+
+  return toJson(result.value());
+}
+
+void
+ApiWorker::respond(QTcpSocket* socket,
+                   const Response& response,
+                   bool keepAlive,
+                   bool cacheHit)
+{
+  static const QHash<int, QByteArray> reasons{
+    { 200, "OK" },
+    { 400, "Bad Request" },
+    { 404, "Not Found" },
+    { 405, "Method Not Allowed" },
+    { 431, "Request Header Fields Too Large" },
+    { 500, "Internal Server Error" },
+  };
+
+  QByteArray head = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' +
+                    reasons.value(response.status) + "\r\n";
+  head += "Content-Type: application/json; charset=utf-8\r\n";
+  head += "Content-Length: " + QByteArray::number(response.body.size()) +
+          "\r\n";
+  head += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+  if (response.status == 200)
+    head += cacheHit ? "X-Cache: HIT\r\n" : "X-Cache: MISS\r\n";
+  head += "\r\n";
+
+  socket->write(head);
+  socket->write(response.body);
+  if (!keepAlive)
+    socket->disconnectFromHost();
+}
+
+ApiWorker::Response
+ApiWorker::error(int status, const QString& message)
+{
+  QJsonObject obj;
+  obj["error"] = message;
+  return { status, QJsonDocument(obj).toJson(QJsonDocument::Compact) };
+}
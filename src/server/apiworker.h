@@ -0,0 +1,111 @@
+/**
+ * @file apiworker.h
+ * @brief Header file for ApiWorker
+ */
+
+#ifndef APIWORKER_H
+#define APIWORKER_H
+
+#include "apistore.h"
+#include <QByteArray>
+#include <QObject>
+#include <QTcpSocket>
+#include <QUrlQuery>
+#include <memory>
+
+class ApiServer;
+
+/**
+ * @brief ApiWorker class serves the connections handed to it by the ApiServer
+ * in its own thread
+ * @details requests are parsed from the connection buffer as they arrive,
+ * several pipelined requests may be answered from a single read. Connections
+ * are kept alive unless the client asks otherwise and closed after being idle
+ * for ApiWorker::s_idleTimeout
+ */
+class ApiWorker : public QObject
+{
+  Q_OBJECT
+public:
+  /**
+   * @brief class constructor
+   * @param index - worker index, used in the connection names
+   * @param qcfVersion - default QCF version of the responses
+   * @param server - pointer to the ApiServer sharing the response cache
+   */
+  ApiWorker(int index, int qcfVersion, ApiServer* server);
+  ~ApiWorker();
+
+public slots:
+  /**
+   * @brief start serving the connection with the given descriptor
+   * @param socketDescriptor - native socket descriptor accepted by the server
+   */
+  void handleConnection(qintptr socketDescriptor);
+
+private:
+  /**
+   * @brief Response struct holds the status and body of a response
+   */
+  struct Response
+  {
+    int status;
+    QByteArray body;
+  };
+  /**
+   * @brief read the available data of the socket and answer every complete
+   * request in the buffer
+   * @param socket - pointer to the client QTcpSocket
+   */
+  void readRequests(QTcpSocket* socket);
+  /**
+   * @brief route a request target to its endpoint
+   * @param target - request target (path and query)
+   * @param cacheHit - set to true if the response is served from the cache
+   * @return Response of the endpoint
+   */
+  Response route(const QString& target, bool& cacheHit);
+  /**
+   * @brief run the lookup of an endpoint
+   * @param path - endpoint path
+   * @param query - QUrlQuery of the request parameters
+   * @return Response of the endpoint
+   */
+  Response lookup(const QString& path, const QUrlQuery& query);
+  /**
+   * @brief write a response to the socket
+   * @param socket - pointer to the client QTcpSocket
+   * @param response - Response to write
+   * @param keepAlive - boolean indicating whether the connection is kept open
+   * @param cacheHit - boolean indicating whether the response was cached
+   */
+  void respond(QTcpSocket* socket,
+               const Response& response,
+               bool keepAlive,
+               bool cacheHit = false);
+  /**
+   * @brief JSON error response
+   * @param status - HTTP status code
+   * @param message - error message
+   * @return Response with the error message as its body
+   */
+  static Response error(int status, const QString& message);
+  /**
+   * @brief idle time in ms after which keep-alive connections are closed
+   */
+  static const int s_idleTimeout = 30000;
+  /**
+   * @brief maximum size of the request line and headers in bytes
+   */
+  static const int s_maxHeaderSize = 16384;
+  const int m_index;
+  const int m_qcfVersion;
+  ApiServer* m_server;
+  /**
+   * @brief database connections of the worker, created in the worker thread
+   * on the first request
+   */
+  std::unique_ptr<ApiStore> m_store;
+};
+
+#endif // APIWORKER_H
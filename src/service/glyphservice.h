@@ -1,6 +1,8 @@
 #ifndef GLYPHSERVICE_H
 #define GLYPHSERVICE_H
 
+#include <QList>
+#include <QPair>
 #include <QString>
 #include <QStringList>
 
@@ -30,9 +32,19 @@ public:
    * @brief gets the verse QCF glyphs for the corresponding QCF page font
    * @param sIdx - sura number (1-114)
    * @param vIdx - verse number
+   * @param page - page of the verse, used to match the page font version
    * @return QString of verse glyphs
    */
-  virtual QString getVerseGlyphs(const int sIdx, const int vIdx) const = 0;
+  virtual QString getVerseGlyphs(const int sIdx,
+                                 const int vIdx,
+                                 const int page) const = 0;
+  /**
+   * @brief gets the [start, end) positions of the page verses relative to the
+   * start of the page body
+   * @param page - Quran page number
+   * @return QList of verse bounds ordered as the verses in the page
+   */
+  virtual QList<QPair<int, int>> getVerseCoordinates(const int page) const = 0;
 };
 
 #endif
@@ -24,7 +24,15 @@ GlyphServiceSqlImpl::getJuzGlyph(const int juz) const
 }
 
 QString
-GlyphServiceSqlImpl::getVerseGlyphs(const int sIdx, const int vIdx) const
+GlyphServiceSqlImpl::getVerseGlyphs(const int sIdx,
+                                    const int vIdx,
+                                    const int page) const
 {
-  return m_glyphRepository.getVerseGlyphs(sIdx, vIdx);
+  return m_glyphRepository.getVerseGlyphs(sIdx, vIdx, page);
+}
+
+QList<QPair<int, int>>
+GlyphServiceSqlImpl::getVerseCoordinates(const int page) const
+{
+  return m_glyphRepository.getVerseCoordinates(page);
 }
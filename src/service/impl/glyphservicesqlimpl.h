@@ -18,7 +18,11 @@ public:
 
   QString getJuzGlyph(const int juz) const override;
 
-  QString getVerseGlyphs(const int sIdx, const int vIdx) const override;
+  QString getVerseGlyphs(const int sIdx,
+                         const int vIdx,
+                         const int page) const override;
+
+  QList<QPair<int, int>> getVerseCoordinates(const int page) const override;
 };
 
 #endif // GLYPHSERVICESQLIMPL_H
@@ -59,6 +59,20 @@ QuranServiceSqlImpl::verseText(const int sIdx, const int vIdx) const
   return m_quranRepository.verseText(sIdx, vIdx);
 }
 
+QList<int>
+QuranServiceSqlImpl::versePages() const
+{
+  return m_quranRepository.versePages();
+}
+
+QList<QPair<Verse, QString>>
+QuranServiceSqlImpl::verseTextRange(const int sIdx,
+                                    const int firstVerse,
+                                    const int lastVerse) const
+{
+  return m_quranRepository.verseTextRange(sIdx, firstVerse, lastVerse);
+}
+
 int
 QuranServiceSqlImpl::surahStartPage(int surahIdx) const
 {
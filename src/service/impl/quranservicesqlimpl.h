@@ -29,6 +29,12 @@ public:
 
   QString verseText(const int sIdx, const int vIdx) const override;
 
+  QList<int> versePages() const override;
+  QList<QPair<Verse, QString>> verseTextRange(
+    const int sIdx,
+    const int firstVerse,
+    const int lastVerse) const override;
+
   int surahStartPage(int surahIdx) const override;
 
   QString surahName(const int sIdx, bool ar) const override;
@@ -23,6 +23,14 @@ TafsirServiceSqlImpl::getTafsir(const int sIdx, const int vIdx)
   return m_tafsirRepository.getTafsir(sIdx, vIdx);
 }
 
+QStringList
+TafsirServiceSqlImpl::getTafsirRange(const int sIdx,
+                                     const int firstVerse,
+                                     const int lastVerse)
+{
+  return m_tafsirRepository.getTafsirRange(sIdx, firstVerse, lastVerse);
+}
+
 std::optional<const Tafsir>
 TafsirServiceSqlImpl::currTafsir() const
 {
@@ -18,6 +18,10 @@ public:
 
   QString getTafsir(const int sIdx, const int vIdx) override;
 
+  QStringList getTafsirRange(const int sIdx,
+                             const int firstVerse,
+                             const int lastVerse) override;
+
   std::optional<const Tafsir> currTafsir() const override;
 };
 
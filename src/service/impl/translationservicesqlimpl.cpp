@@ -17,6 +17,15 @@ TranslationServiceSqlImpl::getTranslation(const int sIdx, const int vIdx) const
   return m_translationRepository.getTranslation(sIdx, vIdx);
 }
 
+QStringList
+TranslationServiceSqlImpl::getTranslationRange(const int sIdx,
+                                               const int firstVerse,
+                                               const int lastVerse) const
+{
+  return m_translationRepository.getTranslationRange(
+    sIdx, firstVerse, lastVerse);
+}
+
 std::optional<const Translation>
 TranslationServiceSqlImpl::currTranslation() const
 {
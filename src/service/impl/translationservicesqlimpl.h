@@ -17,6 +17,10 @@ public:
 
   QString getTranslation(const int sIdx, const int vIdx) const override;
 
+  QStringList getTranslationRange(const int sIdx,
+                                  const int firstVerse,
+                                  const int lastVerse) const override;
+
   std::optional<const Translation> currTranslation() const override;
 
   void loadTranslation() override;
@@ -61,6 +61,23 @@ public:
    * @return QString of the verse text
    */
   virtual QString verseText(const int sIdx, const int vIdx) const = 0;
+  /**
+   * @brief gets the page of every verse in a single query
+   * @return QList of the verse pages indexed by the verse id - 1
+   */
+  virtual QList<int> versePages() const = 0;
+  /**
+   * @brief gets the verses in the given range of a sura with their text in a
+   * single query
+   * @param sIdx - sura number (1-114)
+   * @param firstVerse - first verse number
+   * @param lastVerse - last verse number
+   * @return QList of the verses ordered by verse number, paired with the text
+   */
+  virtual QList<QPair<Verse, QString>> verseTextRange(
+    const int sIdx,
+    const int firstVerse,
+    const int lastVerse) const = 0;
   /**
    * @brief gets the page where the surah begins
    * @param surahIdx - sura number
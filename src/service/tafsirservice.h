@@ -24,6 +24,18 @@ public:
    * @return QString containing the tafsir of the verse
    */
   virtual QString getTafsir(const int sIdx, const int vIdx) = 0;
+  /**
+   * @brief gets the tafsir content for a range of verses in a surah in a
+   * single query using the active tafsir
+   * @param sIdx - surah number
+   * @param firstVerse - first verse number
+   * @param lastVerse - last verse number
+   * @return QStringList of the tafsir content ordered by verse number, empty
+   * for verses without tafsir content
+   */
+  virtual QStringList getTafsirRange(const int sIdx,
+                                     const int firstVerse,
+                                     const int lastVerse) = 0;
   /**
    * @brief getter for m_currTafsir
    * @return pointer to the currently selected Tafasir
@@ -22,6 +22,18 @@ public:
    * @return QString containing the verse translation
    */
   virtual QString getTranslation(const int sIdx, const int vIdx) const = 0;
+  /**
+   * @brief gets the translation of a range of verses in a surah in a single
+   * query using the active translation
+   * @param sIdx - surah number
+   * @param firstVerse - first verse number
+   * @param lastVerse - last verse number
+   * @return QStringList of the translations ordered by verse number, empty
+   * for verses missing from the translation
+   */
+  virtual QStringList getTranslationRange(const int sIdx,
+                                          const int firstVerse,
+                                          const int lastVerse) const = 0;
   /**
    * @brief getter for m_currTr
    * @return pointer to the currently selected translation
@@ -9,6 +9,11 @@ QList<Reciter> Reciter::reciters;
 void
 Reciter::populateReciters()
 {
+  // filled from the catalogs snapshot when it is valid, the reciters
+  // directories were created when the snapshot was written
+  if (!reciters.isEmpty())
+    return;
+
   QFile recitersFile(":/resources/reciters.xml");
   if (!recitersFile.open(QIODevice::ReadOnly))
     qFatal("Couldn't Open Reciters XML, Exiting");
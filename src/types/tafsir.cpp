@@ -4,6 +4,7 @@
 #include <QDir>
 #include <QFile>
 #include <QXmlStreamReader>
+#include <utils/catalogcache.h>
 #include <utils/dirmanager.h>
 
 QList<Tafsir> Tafsir::tafasir;
@@ -11,6 +12,11 @@ QList<Tafsir> Tafsir::tafasir;
 void
 Tafsir::populateTafasir()
 {
+  // the catalog is loaded from the catalogs snapshot, or on idle or first
+  // use if the snapshot is stale
+  if (!tafasir.isEmpty())
+    return;
+
   QFile content(":/resources/files.xml");
   if (!content.open(QIODevice::ReadOnly))
     qCritical("Couldn't Open Files XML");
@@ -88,7 +94,8 @@ Tafsir::isAvailable() const
 {
   const QDir& baseDir = isExtra() ? DirManager::getInstance().downloadsDir()
                                   : DirManager::getInstance().assetsDir();
-  return baseDir.exists("tafasir/" + filename());
+  return CatalogCache::getInstance().isAvailable(
+    baseDir.absoluteFilePath("tafasir/" + filename()));
 }
 
 const bool
@@ -3,6 +3,7 @@
 #include <QDir>
 #include <QFile>
 #include <QXmlStreamReader>
+#include <utils/catalogcache.h>
 #include <utils/dirmanager.h>
 
 QList<Translation> Translation::translations;
@@ -10,6 +11,10 @@ QList<Translation> Translation::translations;
 void
 Translation::populateTranslations()
 {
+  // filled from the catalogs snapshot when it is valid
+  if (!translations.isEmpty())
+    return;
+
   QFile content(":/resources/files.xml");
   if (!content.open(QIODevice::ReadOnly))
     qCritical("Couldn't Open Files XML");
@@ -71,5 +76,6 @@ Translation::isAvailable() const
 {
   const QDir& baseDir = isExtra() ? DirManager::getInstance().downloadsDir()
                                   : DirManager::getInstance().assetsDir();
-  return baseDir.exists("translations/" + filename());
+  return CatalogCache::getInstance().isAvailable(
+    baseDir.absoluteFilePath("translations/" + filename()));
 }
@@ -0,0 +1,15 @@
+/**
+ * @file appinfo.cpp
+ * @brief Implementation file for AppInfo
+ */
+
+#include "appinfo.h"
+#include <QCoreApplication>
+
+void
+AppInfo::apply()
+{
+  QCoreApplication::setApplicationName("Quran Companion");
+  QCoreApplication::setOrganizationName("0xzer0x");
+  QCoreApplication::setApplicationVersion(QC_VERSION);
+}
@@ -0,0 +1,25 @@
+/**
+ * @file appinfo.h
+ * @brief Header file for AppInfo
+ */
+
+#ifndef APPINFO_H
+#define APPINFO_H
+
+/**
+ * @brief AppInfo class sets the application metadata shared by the reader,
+ * the headless runners and the benchmarks
+ * @details the version comes from the project version in CMakeLists.txt, it
+ * keys the catalog snapshots and is written to every report
+ */
+class AppInfo
+{
+public:
+  /**
+   * @brief set the application name, organization and version of the running
+   * QCoreApplication
+   */
+  static void apply();
+};
+
+#endif // APPINFO_H
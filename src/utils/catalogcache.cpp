@@ -0,0 +1,200 @@
+/**
+ * @file catalogcache.cpp
+ * @brief Implementation file for CatalogCache
+ */
+
+#include "catalogcache.h"
+#include <QApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <types/reciter.h>
+#include <types/tafsir.h>
+#include <types/translation.h>
+
+/**
+ * @brief marks the beginning of a catalog snapshot file
+ */
+static const quint32 s_magic = 0x51434354; // QCCT
+
+CatalogCache&
+CatalogCache::getInstance()
+{
+  static CatalogCache cache;
+  return cache;
+}
+
+CatalogCache::CatalogCache()
+  : m_config(Configuration::getInstance())
+  , m_dirMgr(DirManager::getInstance())
+  , m_snapshotPath(m_dirMgr.configDir().absoluteFilePath("catalogs.cache"))
+{
+  for (const QString& dir : { "tafasir", "translations" }) {
+    if (m_dirMgr.downloadsDir().exists(dir))
+      m_watcher.addPath(m_dirMgr.downloadsDir().absoluteFilePath(dir));
+  }
+
+  connect(&m_watcher,
+          &QFileSystemWatcher::directoryChanged,
+          this,
+          &CatalogCache::contentDirChanged);
+}
+
+QByteArray
+CatalogCache::snapshotKey() const
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  for (const QString& resource :
+       { ":/resources/files.xml", ":/resources/reciters.xml" }) {
+    QFile file(resource);
+    if (file.open(QIODevice::ReadOnly))
+      hash.addData(file.readAll());
+  }
+
+  // display names are translated & content paths are resolved on population
+  QByteArray env;
+  QDataStream stream(&env, QIODevice::WriteOnly);
+  stream << qApp->applicationVersion() << int(m_config.language())
+         << m_dirMgr.assetsDir().absolutePath()
+         << m_dirMgr.downloadsDir().absolutePath()
+         << m_dirMgr.basmallahDir().absolutePath();
+
+  // files added or removed outside the app change the directory mtime
+  for (const QString& dir : { "tafasir", "translations", "recitations" }) {
+    QFileInfo info(m_dirMgr.downloadsDir().absoluteFilePath(dir));
+    stream << info.lastModified().toMSecsSinceEpoch();
+  }
+
+  hash.addData(env);
+  return hash.result();
+}
+
+bool
+CatalogCache::load()
+{
+  QFile file(m_snapshotPath);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  QDataStream stream(file.readAll());
+  stream.setVersion(QDataStream::Qt_6_0);
+
+  quint32 magic, version;
+  QByteArray key;
+  stream >> magic >> version >> key;
+  if (magic != s_magic || version != s_version || key != snapshotKey())
+    return false;
+
+  QList<Tafsir> tafasir;
+  QList<Translation> translations;
+  QList<Reciter> reciters;
+  QHash<QString, bool> availability;
+
+  qint64 count;
+  stream >> count;
+  for (qint64 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString id, name, file;
+    bool isText, isExtra;
+    stream >> id >> name >> file >> isText >> isExtra;
+    tafasir.append(Tafsir(id, name, file, isText, isExtra));
+  }
+
+  stream >> count;
+  for (qint64 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString id, name, file;
+    bool isExtra;
+    stream >> id >> name >> file >> isExtra;
+    translations.append(Translation(id, name, file, isExtra));
+  }
+
+  stream >> count;
+  for (qint64 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString dir, display, basmallah, url;
+    bool useId;
+    stream >> dir >> display >> basmallah >> url >> useId;
+    reciters.append(Reciter(dir, display, basmallah, url, useId));
+  }
+
+  stream >> availability;
+  if (stream.status() != QDataStream::Ok) {
+    qWarning() << "Corrupt catalogs snapshot, rebuilding from resources";
+    return false;
+  }
+
+  if (Tafsir::tafasir.isEmpty())
+    Tafsir::tafasir = tafasir;
+  if (Translation::translations.isEmpty())
+    Translation::translations = translations;
+  if (Reciter::reciters.isEmpty())
+    Reciter::reciters = reciters;
+  m_availability.insert(availability);
+
+  return true;
+}
+
+void
+CatalogCache::save()
+{
+  if (Tafsir::tafasir.isEmpty() || Translation::translations.isEmpty() ||
+      Reciter::reciters.isEmpty())
+    return;
+
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_6_0);
+  stream << s_magic << s_version << snapshotKey();
+
+  stream << qint64(Tafsir::tafasir.size());
+  for (const Tafsir& t : Tafsir::tafasir) {
+    stream << t.id() << t.displayName() << t.filename() << t.isText()
+           << t.isExtra();
+    t.isAvailable();
+  }
+
+  stream << qint64(Translation::translations.size());
+  for (const Translation& t : Translation::translations) {
+    stream << t.id() << t.displayName() << t.filename() << t.isExtra();
+    t.isAvailable();
+  }
+
+  stream << qint64(Reciter::reciters.size());
+  for (const Reciter& r : Reciter::reciters) {
+    stream << r.baseDirName() << r.displayName() << r.basmallahPath()
+           << r.baseUrl() << r.useId();
+  }
+
+  // the availability of every content file is resolved by the loops above
+  stream << m_availability;
+
+  QSaveFile file(m_snapshotPath);
+  if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() ||
+      !file.commit())
+    qWarning() << "Couldn't write catalogs snapshot to" << m_snapshotPath;
+}
+
+bool
+CatalogCache::isAvailable(const QString& path)
+{
+  auto it = m_availability.constFind(path);
+  if (it != m_availability.cend())
+    return it.value();
+
+  bool exists = QFileInfo::exists(path);
+  m_availability.insert(path, exists);
+  return exists;
+}
+
+void
+CatalogCache::contentDirChanged(const QString& path)
+{
+  QString prefix = path + '/';
+  m_availability.removeIf(
+    [&prefix](const QHash<QString, bool>::iterator& it) {
+      return it.key().startsWith(prefix);
+    });
+
+  save();
+}
@@ -0,0 +1,93 @@
+/**
+ * @file catalogcache.h
+ * @brief Header file for CatalogCache
+ */
+
+#ifndef CATALOGCACHE_H
+#define CATALOGCACHE_H
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <utils/configuration.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @brief CatalogCache class keeps a binary snapshot of the resolved tafsir,
+ * translation and reciter catalogs along with the availability of the
+ * content files, so they are loaded in a single read instead of parsing the
+ * XML resources at every launch
+ * @details the snapshot is keyed by a hash of the catalog resources, the UI
+ * language, the content directories and the modification time of the
+ * downloaded content directories. The downloads directory is watched while
+ * the app is running, the availability of the changed directory is dropped
+ * and the snapshot is rewritten
+ */
+class CatalogCache : public QObject
+{
+  Q_OBJECT
+public:
+  /**
+   * @brief get a reference to the single class instance
+   * @return reference to the static class instance
+   */
+  static CatalogCache& getInstance();
+  /**
+   * @brief fill the empty catalogs from the snapshot file
+   * @return boolean indicating whether the snapshot is valid and was loaded
+   */
+  bool load();
+  /**
+   * @brief write the current catalogs to the snapshot file, nothing is written
+   * unless all the catalogs are populated
+   */
+  void save();
+  /**
+   * @brief check whether the content file at the given path exists, the file
+   * system is only checked on the first call for each path
+   * @param path - absolute path of the content file
+   * @return boolean indicating whether the file exists
+   */
+  bool isAvailable(const QString& path);
+
+private:
+  CatalogCache();
+  /**
+   * @brief snapshot format version, should be incremented whenever the
+   * serialized layout changes
+   */
+  static const quint32 s_version = 1;
+  /**
+   * @brief compute the key the snapshot is valid for
+   * @return QByteArray of the key hash
+   */
+  QByteArray snapshotKey() const;
+  /**
+   * @brief callback for changes in the watched downloads directories
+   * @param path - absolute path of the changed directory
+   */
+  void contentDirChanged(const QString& path);
+  /**
+   * @brief reference to the singleton Configuration instance
+   */
+  Configuration& m_config;
+  /**
+   * @brief reference to the singleton DirManager instance
+   */
+  const DirManager& m_dirMgr;
+  /**
+   * @brief path of the snapshot file in the config directory
+   */
+  const QString m_snapshotPath;
+  /**
+   * @brief watcher for the downloaded tafasir & translations directories
+   */
+  QFileSystemWatcher m_watcher;
+  /**
+   * @brief availability of the content files by their absolute paths
+   */
+  QHash<QString, bool> m_availability;
+};
+
+#endif // CATALOGCACHE_H
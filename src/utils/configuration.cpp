@@ -48,20 +48,34 @@ Configuration::checkGroups()
 void
 Configuration::checkConfGroup(int gId)
 {
+  // GUI defaults are left for the first GUI run in the headless mode
+  bool gui = qobject_cast<QGuiApplication*>(QCoreApplication::instance());
   switch (gId) {
     case 0:
       m_settings.setValue("Language",
                           m_settings.value("Language", (int)QLocale::English));
-      m_settings.setValue(
-        "Theme",
-        m_settings.value("Theme",
-                         QGuiApplication::styleHints()->colorScheme() ==
-                             Qt::ColorScheme::Dark
-                           ? 2
-                           : 0));
+      if (gui) {
+        m_settings.setValue(
+          "Theme",
+          m_settings.value("Theme",
+                           QGuiApplication::styleHints()->colorScheme() ==
+                               Qt::ColorScheme::Dark
+                             ? 2
+                             : 0));
+      }
       m_settings.setValue("VOTD", m_settings.value("VOTD", true));
       m_settings.setValue("MissingFileWarning",
                           m_settings.value("MissingFileWarning", true));
+      m_settings.setValue("GaplessPlayback",
+                          m_settings.value("GaplessPlayback", true));
+      m_settings.setValue("PcmAudioEngine",
+                          m_settings.value("PcmAudioEngine", false));
+      m_settings.setValue("PcmCacheSize",
+                          m_settings.value("PcmCacheSize", 128));
+      m_settings.setValue("StreamMissingVerses",
+                          m_settings.value("StreamMissingVerses", false));
+      m_settings.setValue("DownloadConnections",
+                          m_settings.value("DownloadConnections", 4));
       m_settings.setValue("DownloadsDir", m_settings.value("DownloadsDir", ""));
       break;
     case 1:
@@ -74,15 +88,19 @@ Configuration::checkConfGroup(int gId)
       m_settings.setValue("QCF1Size", m_settings.value("QCF1Size", 22));
       m_settings.setValue("QCF2Size", m_settings.value("QCF2Size", 20));
       m_settings.setValue("QCF", m_settings.value("QCF", 1));
+      m_settings.setValue("QCFFontBudget",
+                          m_settings.value("QCFFontBudget", 64));
       m_settings.setValue("VerseType", m_settings.value("VerseType", 0));
       m_settings.setValue("VerseFontSize",
                           m_settings.value("VerseFontSize", 20));
       m_settings.setValue("Tafsir", m_settings.value("Tafsir", "sa3dy"));
       m_settings.setValue("Translation",
                           m_settings.value("Translation", "en_khattab"));
-      m_settings.setValue(
-        "SideContentFont",
-        m_settings.value("SideContentFont", QFont("Expo Arabic", 14)));
+      if (gui) {
+        m_settings.setValue(
+          "SideContentFont",
+          m_settings.value("SideContentFont", QFont("Expo Arabic", 14)));
+      }
       m_settings.endGroup();
       break;
   }
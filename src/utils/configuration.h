@@ -22,8 +22,10 @@ public:
   {
     SinglePage, ///< Single Quran page, side panel is used for displaying verses
                 ///< with translation
-    DoublePage  ///< Two Quran pages, both panels are used to display Quran
+    DoublePage, ///< Two Quran pages, both panels are used to display Quran
                 ///< pages, no translation
+    ContinuousScroll ///< Vertical strip of Quran pages scrolled continuously,
+                     ///< no side panel
   };
 
   static Configuration& getInstance();
@@ -0,0 +1,199 @@
+/**
+ * @file corpusquery.cpp
+ * @brief Implementation file for CorpusQuery
+ */
+
+#include "corpusquery.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <service/servicefactory.h>
+#include <types/tafsir.h>
+#include <types/translation.h>
+
+/**
+ * @brief flatten the given content to a single tab separated column
+ * @param content - QString of the content
+ * @return QString without tabs and line breaks
+ */
+static QString
+column(QString content)
+{
+  return content.replace('\t', ' ').replace('\r', ' ').replace('\n', ' ');
+}
+
+CorpusQuery::CorpusQuery(Format format)
+  : m_format(format)
+  , m_out(stdout)
+  , m_quranService(ServiceFactory::quranService())
+{
+  m_out.setEncoding(QStringConverter::Utf8);
+}
+
+bool
+CorpusQuery::setTranslation(const QString& id)
+{
+  Translation::populateTranslations();
+  m_translationService = ServiceFactory::translationService();
+  return m_translationService->setCurrentTranslation(id);
+}
+
+bool
+CorpusQuery::setTafsir(const QString& id)
+{
+  Tafsir::populateTafasir();
+  m_tafsirService = ServiceFactory::tafsirService();
+  return m_tafsirService->setCurrentTafsir(id);
+}
+
+std::optional<CorpusQuery::Range>
+CorpusQuery::parseRange(const QString& range)
+{
+  if (range == "all")
+    return Range{ 1, 1, 114, Verse::surahVerseCount(114) };
+
+  QStringList bounds = range.split('-');
+  if (bounds.size() > 2)
+    return std::nullopt;
+
+  QStringList first = bounds.first().split(':');
+  QStringList last = bounds.last().split(':');
+  if (first.size() > 2 || last.size() > 2)
+    return std::nullopt;
+
+  Range r;
+  r.firstSurah = first.first().toInt();
+  r.firstVerse = first.size() == 2 ? first.last().toInt() : 1;
+  if (bounds.size() == 2 && last.size() == 1 && first.size() == 2) {
+    // surah:verse-verse
+    r.lastSurah = r.firstSurah;
+    r.lastVerse = last.first().toInt();
+  } else {
+    r.lastSurah = last.first().toInt();
+    r.lastVerse = last.size() == 2 ? last.last().toInt()
+                                   : Verse::surahVerseCount(r.lastSurah);
+  }
+
+  bool valid = r.firstVerse >= 1 &&
+               r.firstVerse <= Verse::surahVerseCount(r.firstSurah) &&
+               r.lastVerse >= 1 &&
+               r.lastVerse <= Verse::surahVerseCount(r.lastSurah) &&
+               Verse::id(r.firstSurah, r.firstVerse) <=
+                 Verse::id(r.lastSurah, r.lastVerse);
+  if (!valid)
+    return std::nullopt;
+
+  return r;
+}
+
+bool
+CorpusQuery::query(const QString& range)
+{
+  std::optional<Range> r = parseRange(range);
+  if (!r.has_value())
+    return false;
+
+  begin();
+  for (int surah = r->firstSurah; surah <= r->lastSurah; surah++) {
+    int first = surah == r->firstSurah ? r->firstVerse : 1;
+    int last = surah == r->lastSurah ? r->lastVerse
+                                     : Verse::surahVerseCount(surah);
+    writeSurahRange(surah, first, last);
+    m_out.flush();
+  }
+  end();
+
+  return true;
+}
+
+void
+CorpusQuery::search(const QString& text, bool wholeWord)
+{
+  int pages[2] = { 1, 604 };
+  QList<Verse> results = m_quranService->searchVerses(text, pages, wholeWord);
+
+  begin();
+  for (const Verse& v : results) {
+    QString translation, tafsir;
+    if (m_translationService != nullptr)
+      translation = m_translationService->getTranslation(v.surah(), v.number());
+    if (m_tafsirService != nullptr)
+      tafsir = m_tafsirService->getTafsir(v.surah(), v.number());
+
+    writeVerse(v,
+               m_quranService->verseText(v.surah(), v.number()),
+               translation,
+               tafsir);
+  }
+  end();
+}
+
+void
+CorpusQuery::writeSurahRange(int surah, int firstVerse, int lastVerse)
+{
+  QList<QPair<Verse, QString>> verses =
+    m_quranService->verseTextRange(surah, firstVerse, lastVerse);
+
+  QStringList translations, tafasir;
+  if (m_translationService != nullptr) {
+    translations =
+      m_translationService->getTranslationRange(surah, firstVerse, lastVerse);
+  }
+  if (m_tafsirService != nullptr)
+    tafasir = m_tafsirService->getTafsirRange(surah, firstVerse, lastVerse);
+
+  for (const QPair<Verse, QString>& verse : verses) {
+    int idx = verse.first.number() - firstVerse;
+    writeVerse(verse.first,
+               verse.second,
+               translations.value(idx),
+               tafasir.value(idx));
+  }
+}
+
+void
+CorpusQuery::writeVerse(const Verse& verse,
+                        const QString& text,
+                        const QString& translation,
+                        const QString& tafsir)
+{
+  if (m_format == Json) {
+    QJsonObject obj;
+    obj["surah"] = verse.surah();
+    obj["verse"] = verse.number();
+    obj["page"] = verse.page();
+    obj["text"] = text;
+    if (m_translationService != nullptr)
+      obj["translation"] = translation;
+    if (m_tafsirService != nullptr)
+      obj["tafsir"] = tafsir;
+
+    m_out << (m_written ? ",\n" : "")
+          << QJsonDocument(obj).toJson(QJsonDocument::Compact);
+  } else {
+    m_out << verse.surah() << ':' << verse.number() << '\t' << verse.page()
+          << '\t' << column(text);
+    if (m_translationService != nullptr)
+      m_out << '\t' << column(translation);
+    if (m_tafsirService != nullptr)
+      m_out << '\t' << column(tafsir);
+    m_out << '\n';
+  }
+
+  m_written++;
+}
+
+void
+CorpusQuery::begin()
+{
+  m_written = 0;
+  if (m_format == Json)
+    m_out << "[\n";
+}
+
+void
+CorpusQuery::end()
+{
+  if (m_format == Json)
+    m_out << (m_written ? "\n" : "") << "]\n";
+  m_out.flush();
+}
@@ -0,0 +1,120 @@
+/**
+ * @file corpusquery.h
+ * @brief Header file for CorpusQuery
+ */
+
+#ifndef CORPUSQUERY_H
+#define CORPUSQUERY_H
+
+#include <QString>
+#include <QTextStream>
+#include <optional>
+#include <service/quranservice.h>
+#include <service/tafsirservice.h>
+#include <service/translationservice.h>
+
+/**
+ * @brief CorpusQuery class writes verses, their translation and tafsir to
+ * stdout for the headless command line mode
+ * @details only the services and their repositories are used, no widgets,
+ * fonts or styles are loaded. Verse ranges are fetched one surah at a time
+ * and written as they are fetched, as tab separated lines or as a JSON array
+ * with an object per line
+ */
+class CorpusQuery
+{
+public:
+  /**
+   * @brief Format enum represents the supported output formats
+   */
+  enum Format
+  {
+    Text, ///< a tab separated line per verse
+    Json  ///< a JSON array with an object per verse
+  };
+  /**
+   * @brief class constructor
+   * @param format - CorpusQuery::Format to write the results in
+   */
+  explicit CorpusQuery(Format format);
+  /**
+   * @brief include the given translation in the results
+   * @param id - translation id
+   * @return boolean indicating whether the translation is available
+   */
+  bool setTranslation(const QString& id);
+  /**
+   * @brief include the given tafsir in the results
+   * @param id - tafsir id
+   * @return boolean indicating whether the tafsir is available
+   */
+  bool setTafsir(const QString& id);
+  /**
+   * @brief write the verses in the given range
+   * @param range - 'all', 'surah', 'surah:verse', 'surah:verse-verse',
+   * 'surah-surah' or 'surah:verse-surah:verse'
+   * @return boolean indicating whether the range is valid
+   */
+  bool query(const QString& range);
+  /**
+   * @brief write the verses matching the given search text
+   * @param text - text to search for
+   * @param wholeWord - boolean indicating whether to match whole words only
+   */
+  void search(const QString& text, bool wholeWord);
+
+private:
+  /**
+   * @brief Range struct holds the bounds of a verse range
+   */
+  struct Range
+  {
+    int firstSurah;
+    int firstVerse;
+    int lastSurah;
+    int lastVerse;
+  };
+  /**
+   * @brief parse a verse range, see query()
+   * @param range - QString of the range
+   * @return the parsed Range, std::nullopt if the range is invalid
+   */
+  static std::optional<Range> parseRange(const QString& range);
+  /**
+   * @brief fetch and write the given verses of a surah
+   * @param surah - surah number
+   * @param firstVerse - first verse number
+   * @param lastVerse - last verse number
+   */
+  void writeSurahRange(int surah, int firstVerse, int lastVerse);
+  /**
+   * @brief write a single verse in the output format
+   * @param verse - Verse to write
+   * @param text - verse text
+   * @param translation - verse translation, ignored if no translation is set
+   * @param tafsir - verse tafsir, ignored if no tafsir is set
+   */
+  void writeVerse(const Verse& verse,
+                  const QString& text,
+                  const QString& translation,
+                  const QString& tafsir);
+  /**
+   * @brief start the output, opens the JSON array
+   */
+  void begin();
+  /**
+   * @brief end the output, closes the JSON array
+   */
+  void end();
+  const Format m_format;
+  QTextStream m_out;
+  const QuranService* m_quranService;
+  TranslationService* m_translationService = nullptr;
+  TafsirService* m_tafsirService = nullptr;
+  /**
+   * @brief number of verses written so far
+   */
+  int m_written = 0;
+};
+
+#endif // CORPUSQUERY_H
@@ -1,7 +1,11 @@
 #include "fontmanager.h"
 #include "configuration.h"
+#include "fontmetricscache.h"
 #include <QApplication>
+#include <QFile>
 #include <QFontDatabase>
+#include <QThreadPool>
+#include <algorithm>
 
 FontManager&
 FontManager::getInstance()
@@ -28,9 +32,10 @@ FontManager::loadQcf()
 {
   QFontDatabase::addApplicationFont(
     m_dirMgr.fontsDir().filePath("QCFV1/QCF_BSML.ttf"));
+  m_qcfV1Dir.setPath(m_dirMgr.fontsDir().absoluteFilePath("QCFV1"));
   switch (m_config.qcfVersion()) {
     case 1:
-      m_dirMgr.setFontsDir(m_dirMgr.fontsDir().absoluteFilePath("QCFV1"));
+      m_dirMgr.setFontsDir(m_qcfV1Dir);
       m_qcfFontPrefix = "QCF_P";
       break;
     case 2:
@@ -39,20 +44,171 @@ FontManager::loadQcf()
       break;
   }
 
-  // add required fonts
-  for (int i = 1; i < 605; i++) {
-    QString fontName = pageFontname(i) + ".ttf";
-
-    if (m_config.qcfVersion() == 2 && !m_dirMgr.fontsDir().exists(fontName)) {
-      m_config.settings().setValue("Reader/QCF", 1);
-      m_config.settings().sync();
-      qFatal() << m_dirMgr.fontsDir().filePath(fontName)
-               << " font file not found, fallback to QCF v1";
-    } else
-      QFontDatabase::addApplicationFont(m_dirMgr.fontsDir().filePath(fontName));
+  // page fonts are registered on first use
+  m_fontBudget =
+    std::max(8, m_config.settings().value("Reader/QCFFontBudget").toInt());
+}
+
+void
+FontManager::loadPageFont(int page)
+{
+  m_recentPages.removeOne(page);
+  m_recentPages.append(page);
+  if (m_pageFontIds.contains(page))
+    return;
+
+  m_pendingPages.remove(page);
+  bool fallback = pageQcfVersion(page) != m_config.qcfVersion();
+  QFile fontFile(pageFontFile(page, fallback ? 1 : m_config.qcfVersion()));
+  if (!fontFile.open(QIODevice::ReadOnly)) {
+    qWarning() << fontFile.fileName() << "font file could not be opened";
+    m_recentPages.removeOne(page);
+    return;
+  }
+
+  registerPageFont(page, fontFile.readAll(), fallback);
+}
+
+void
+FontManager::preloadNeighbours(int page)
+{
+  for (int p = std::max(1, page - 2); p <= std::min(604, page + 2); p++) {
+    if (p == page || m_pageFontIds.contains(p) || m_pendingPages.contains(p))
+      continue;
+
+    m_pendingPages.insert(p);
+    int version = m_config.qcfVersion();
+    QString file = pageFontFile(p, version);
+    QString fallbackFile = pageFontFile(p, 1);
+    QThreadPool::globalInstance()->start([this, p, file, fallbackFile]() {
+      QFile fontFile(file);
+      bool fallback = !fontFile.exists();
+      if (fallback)
+        fontFile.setFileName(fallbackFile);
+
+      QByteArray data;
+      if (fontFile.open(QIODevice::ReadOnly))
+        data = fontFile.readAll();
+
+      // fonts are registered in the main thread
+      QMetaObject::invokeMethod(
+        qApp,
+        [this, p, data, fallback]() {
+          if (!m_pendingPages.remove(p) || data.isEmpty())
+            return;
+          m_recentPages.append(p);
+          registerPageFont(p, data, fallback);
+        },
+        Qt::QueuedConnection);
+    });
   }
 }
 
+void
+FontManager::registerPageFont(int page, const QByteArray& data, bool fallback)
+{
+  if (fallback) {
+    qWarning() << "QCF" << m_config.qcfVersion() << "font of page" << page
+               << "not found, fallback to QCF v1";
+    m_fallbackPages.insert(page);
+  }
+
+  // a page that failed to register is retried on its next use
+  int id = QFontDatabase::addApplicationFontFromData(data);
+  if (id == -1) {
+    qWarning() << "Failed to load the font of page" << page;
+    m_recentPages.removeOne(page);
+    m_fallbackPages.remove(page);
+    return;
+  }
+
+  m_pageFontIds.insert(page, id);
+  evictPageFonts();
+}
+
+void
+FontManager::pinPageFont(QObject* owner, int page)
+{
+  auto it = m_pinOwners.constFind(owner);
+  if (it != m_pinOwners.cend() && it.value() == page)
+    return;
+
+  if (it == m_pinOwners.cend()) {
+    QObject::connect(owner, &QObject::destroyed, qApp, [this, owner]() {
+      unpinPageFont(owner);
+    });
+  } else if (--m_pinCounts[it.value()] == 0) {
+    m_pinCounts.remove(it.value());
+  }
+
+  m_pinOwners.insert(owner, page);
+  m_pinCounts[page]++;
+  evictPageFonts();
+}
+
+void
+FontManager::unpinPageFont(QObject* owner)
+{
+  auto it = m_pinOwners.find(owner);
+  if (it == m_pinOwners.end())
+    return;
+
+  int page = it.value();
+  m_pinOwners.erase(it);
+  if (--m_pinCounts[page] == 0)
+    m_pinCounts.remove(page);
+  evictPageFonts();
+}
+
+void
+FontManager::evictPageFonts()
+{
+  // pinned fonts are skipped, they are still displayed
+  qsizetype idx = 0;
+  while (m_pageFontIds.size() > m_fontBudget && idx < m_recentPages.size()) {
+    int page = m_recentPages.at(idx);
+    if (m_pinCounts.contains(page)) {
+      idx++;
+      continue;
+    }
+
+    m_recentPages.removeAt(idx);
+    FontMetricsCache::getInstance().removeFamily(pageFontFamily(page));
+    QFontDatabase::removeApplicationFont(m_pageFontIds.take(page));
+    m_fallbackPages.remove(page);
+  }
+}
+
+int
+FontManager::pageQcfVersion(int page)
+{
+  if (m_config.qcfVersion() == 1 || m_fallbackPages.contains(page))
+    return 1;
+  if (m_pageFontIds.contains(page))
+    return m_config.qcfVersion();
+
+  return QFile::exists(pageFontFile(page, m_config.qcfVersion()))
+           ? m_config.qcfVersion()
+           : 1;
+}
+
+QString
+FontManager::pageFontFile(int page, int qcfVersion) const
+{
+  QString number = QString::number(page).rightJustified(3, '0');
+  if (qcfVersion == 1)
+    return m_qcfV1Dir.filePath("QCF_P" + number + ".ttf");
+
+  return m_dirMgr.fontsDir().filePath("QCF2" + number + ".ttf");
+}
+
+QString
+FontManager::pageFontFamily(int page) const
+{
+  QString prefix = m_fallbackPages.contains(page) ? "QCF_P" : m_qcfFontPrefix;
+  return prefix + QString::number(page).rightJustified(3, '0');
+}
+
 void
 FontManager::loadUiFonts()
 {
@@ -83,7 +239,8 @@ FontManager::qcfExists()
 QString
 FontManager::pageFontname(int page)
 {
-  return m_qcfFontPrefix + QString::number(page).rightJustified(3, '0');
+  loadPageFont(page);
+  return pageFontFamily(page);
 }
 
 QString
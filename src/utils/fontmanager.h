@@ -3,14 +3,59 @@
 
 #include "configuration.h"
 #include "dirmanager.h"
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
 #include <QString>
 
+/**
+ * @brief FontManager class loads the UI fonts and manages the QCF page fonts
+ * @details page fonts are registered on first use, neighbouring pages are
+ * preloaded in the background and the least recently used fonts are removed
+ * once the number of registered page fonts exceeds the budget set in
+ * "Reader/QCFFontBudget". Fonts pinned by the widgets displaying them are
+ * never removed, the budget may be exceeded while they are pinned
+ */
 class FontManager
 {
 public:
   static FontManager& getInstance();
+  /**
+   * @brief get the QCF font family of the given page, registering the font if
+   * it is not loaded
+   * @param page - page number (1-604)
+   * @return QString of the page font family
+   */
   QString pageFontname(int page);
   QString verseFontname(Configuration::VerseType type, int page);
+  /**
+   * @brief get the QCF version used to display the given page, which is v1 if
+   * the v2 font file of the page is missing
+   * @param page - page number (1-604)
+   * @return QCF version of the page glyphs
+   */
+  int pageQcfVersion(int page);
+  /**
+   * @brief register the fonts of the pages around the given page on a
+   * background thread
+   * @param page - page number (1-604)
+   */
+  void preloadNeighbours(int page);
+  /**
+   * @brief keep the font of the given page registered while the owner
+   * displays it, replaces the page previously pinned by the owner
+   * @details the pin is released when the owner is destroyed or unpinned,
+   * should be called before the font family of the page is requested
+   * @param owner - pointer to the object displaying the page glyphs
+   * @param page - page number (1-604)
+   */
+  void pinPageFont(QObject* owner, int page);
+  /**
+   * @brief release the page font pinned by the owner, if any
+   * @param owner - pointer to the object that pinned a page font
+   */
+  void unpinPageFont(QObject* owner);
   void loadFonts();
   bool qcfExists();
 
@@ -18,9 +63,62 @@ private:
   FontManager();
   void loadQcf();
   void loadUiFonts();
+  /**
+   * @brief register the page font if it is not loaded and mark it as the most
+   * recently used
+   * @param page - page number (1-604)
+   */
+  void loadPageFont(int page);
+  /**
+   * @brief register font data read for the page and update the font
+   * bookkeeping
+   * @param page - page number (1-604)
+   * @param data - font file contents
+   * @param fallback - true if the data is the QCF v1 font of the page
+   */
+  void registerPageFont(int page, const QByteArray& data, bool fallback);
+  /**
+   * @brief remove the least recently used unpinned page fonts until the
+   * budget is met
+   */
+  void evictPageFonts();
+  QString pageFontFile(int page, int qcfVersion) const;
+  QString pageFontFamily(int page) const;
   Configuration& m_config;
   DirManager& m_dirMgr;
   QString m_qcfFontPrefix;
+  /**
+   * @brief directory of the bundled QCF v1 fonts used for fallback
+   */
+  QDir m_qcfV1Dir;
+  /**
+   * @brief maximum number of registered page fonts
+   */
+  int m_fontBudget = 64;
+  /**
+   * @brief application font id of each registered page font
+   */
+  QHash<int, int> m_pageFontIds;
+  /**
+   * @brief registered pages ordered from least to most recently used
+   */
+  QList<int> m_recentPages;
+  /**
+   * @brief number of owners pinning each page font
+   */
+  QHash<int, int> m_pinCounts;
+  /**
+   * @brief page pinned by each owner
+   */
+  QHash<QObject*, int> m_pinOwners;
+  /**
+   * @brief pages being preloaded in the background
+   */
+  QSet<int> m_pendingPages;
+  /**
+   * @brief QCF v2 pages with missing font files, displayed using QCF v1
+   */
+  QSet<int> m_fallbackPages;
 };
 
 #endif // FONTMANAGER_H
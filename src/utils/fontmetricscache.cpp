@@ -0,0 +1,80 @@
+#include "fontmetricscache.h"
+
+FontMetricsCache&
+FontMetricsCache::getInstance()
+{
+  static FontMetricsCache cache;
+  return cache;
+}
+
+FontMetricsCache::Entry::Entry(const QFont& font)
+  : metrics(font)
+  , height(metrics.height())
+  , spaceAdvance(metrics.horizontalAdvance(' '))
+{
+}
+
+FontMetricsCache::Entry&
+FontMetricsCache::entry(const QFont& font)
+{
+  Key key(font.family(), font.pointSize());
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+    it = m_entries.insert(key, Entry(font));
+
+  return it.value();
+}
+
+int
+FontMetricsCache::height(const QFont& font)
+{
+  QMutexLocker locker(&m_mutex);
+  return entry(font).height;
+}
+
+int
+FontMetricsCache::spaceAdvance(const QFont& font)
+{
+  QMutexLocker locker(&m_mutex);
+  return entry(font).spaceAdvance;
+}
+
+int
+FontMetricsCache::horizontalAdvance(const QFont& font, const QString& text)
+{
+  QMutexLocker locker(&m_mutex);
+  Entry& e = entry(font);
+  auto it = e.advances.find(text);
+  if (it == e.advances.end())
+    it = e.advances.insert(text, e.metrics.horizontalAdvance(text));
+
+  return it.value();
+}
+
+QSize
+FontMetricsCache::pageLineSize(const QFont& font, int page, const QString& line)
+{
+  QMutexLocker locker(&m_mutex);
+  Entry& e = entry(font);
+  auto it = e.lineSizes.find(page);
+  if (it == e.lineSizes.end())
+    it = e.lineSizes.insert(page, e.metrics.size(Qt::TextSingleLine, line));
+
+  return it.value();
+}
+
+void
+FontMetricsCache::removeFamily(const QString& family)
+{
+  QMutexLocker locker(&m_mutex);
+  m_entries.removeIf([&family](const QHash<Key, Entry>::iterator it) {
+    return it.key().first == family;
+  });
+}
+
+void
+FontMetricsCache::clear()
+{
+  QMutexLocker locker(&m_mutex);
+  m_entries.clear();
+}
@@ -0,0 +1,86 @@
+#ifndef FONTMETRICSCACHE_H
+#define FONTMETRICSCACHE_H
+
+#include <QFont>
+#include <QFontMetrics>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QSize>
+#include <QString>
+
+/**
+ * @brief FontMetricsCache class holds the font metrics used in Quran page
+ * layout keyed by font family and point size, to avoid creating new
+ * QFontMetrics on every page construction
+ * @details access is serialized with a mutex, pages may be built in worker
+ * threads
+ */
+class FontMetricsCache
+{
+public:
+  static FontMetricsCache& getInstance();
+  /**
+   * @brief get the line height of the given font
+   * @param font - QFont with the family and point size to use
+   * @return line height in pixels
+   */
+  int height(const QFont& font);
+  /**
+   * @brief get the horizontal advance of a single space in the given font
+   * @param font - QFont with the family and point size to use
+   * @return space advance in pixels
+   */
+  int spaceAdvance(const QFont& font);
+  /**
+   * @brief get the horizontal advance of the text in the given font
+   * @param font - QFont with the family and point size to use
+   * @param text - QString to measure
+   * @return text advance in pixels
+   */
+  int horizontalAdvance(const QFont& font, const QString& text);
+  /**
+   * @brief get the size of the measured page line, measured once per page
+   * @param font - QFont with the family and point size to use
+   * @param page - page number the line belongs to
+   * @param line - QString of the page line to measure
+   * @return QSize of the line
+   */
+  QSize pageLineSize(const QFont& font, int page, const QString& line);
+  /**
+   * @brief remove the cached metrics of all the sizes of a font family
+   * @param family - font family to remove
+   */
+  void removeFamily(const QString& family);
+  /**
+   * @brief remove all cached metrics
+   */
+  void clear();
+
+private:
+  FontMetricsCache() = default;
+  typedef QPair<QString, int> Key;
+  /**
+   * @brief Entry struct holds the metrics of a single font family & size
+   */
+  struct Entry
+  {
+    explicit Entry(const QFont& font);
+    QFontMetrics metrics;
+    int height;
+    int spaceAdvance;
+    /**
+     * @brief measured line size for each page using the font
+     */
+    QHash<int, QSize> lineSizes;
+    /**
+     * @brief advances of measured strings (headers, footers)
+     */
+    QHash<QString, int> advances;
+  };
+  Entry& entry(const QFont& font);
+  QHash<Key, Entry> m_entries;
+  QMutex m_mutex;
+};
+
+#endif // FONTMETRICSCACHE_H
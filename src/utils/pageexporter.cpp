@@ -0,0 +1,179 @@
+/**
+ * @file pageexporter.cpp
+ * @brief Implementation file for PageExporter
+ */
+
+#include "pageexporter.h"
+#include <QAbstractTextDocumentLayout>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QPdfWriter>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <algorithm>
+#include <memory>
+
+PageExporter::PageExporter(int firstPage,
+                           int lastPage,
+                           Format format,
+                           int dpi,
+                           const QString& output)
+  : m_firstPage(std::clamp(firstPage, 1, 604))
+  , m_lastPage(std::clamp(lastPage, m_firstPage, 604))
+  , m_format(format)
+  , m_dpi(dpi)
+  , m_scale(dpi / 96.0)
+  , m_output(output)
+  , m_palette(qApp->palette())
+{
+  // batches are kept within the minimum page font budget, the fonts of a
+  // batch must stay registered until its pages are drawn
+  int batchSize =
+    std::clamp(QThreadPool::globalInstance()->maxThreadCount(), 1, 8);
+  for (int i = 0; i < batchSize; i++)
+    m_browsers.append(new QuranPageBrowser(&m_host, m_firstPage));
+}
+
+bool
+PageExporter::run()
+{
+  QTextStream out(stdout);
+  QElapsedTimer timer;
+  timer.start();
+
+  std::unique_ptr<QPdfWriter> pdfWriter;
+  QPainter pdfPainter;
+  if (m_format == Pdf) {
+    pdfWriter = std::make_unique<QPdfWriter>(m_output);
+    pdfWriter->setCreator(qApp->applicationName());
+    pdfWriter->setResolution(m_dpi);
+    pdfWriter->setPageMargins(QMarginsF(0, 0, 0, 0));
+  } else if (!QDir().mkpath(m_output)) {
+    qCritical() << "Couldn't create export directory" << m_output;
+    return false;
+  }
+
+  bool exported = true;
+  int total = m_lastPage - m_firstPage + 1;
+  for (int first = m_firstPage; first <= m_lastPage;
+       first += m_browsers.size()) {
+    int last = std::min(m_lastPage, first + int(m_browsers.size()) - 1);
+
+    // database connections are bound to the GUI thread
+    QList<QuranPageBrowser*> batch;
+    for (int page = first; page <= last; page++) {
+      QuranPageBrowser* browser = m_browsers.at(page - first);
+      browser->preparePage(page, true);
+      batch.append(browser);
+    }
+
+    if (m_format == Png) {
+      QList<bool> saved = QtConcurrent::blockingMapped<QList<bool>>(
+        batch, [this](QuranPageBrowser* b) { return exportPng(b); });
+      exported = exported && !saved.contains(false);
+    } else {
+      // documents are laid out concurrently, the PDF is written in order
+      QList<QTextDocument*> docs =
+        QtConcurrent::blockingMapped<QList<QTextDocument*>>(
+          batch, [this](QuranPageBrowser* b) { return layoutPdfPage(b); });
+
+      for (QTextDocument* doc : docs) {
+        QPageSize pageSize(doc->size() * 72.0 / 96.0,
+                           QPageSize::Point,
+                           QString(),
+                           QPageSize::ExactMatch);
+        pdfWriter->setPageSize(pageSize);
+        if (!pdfPainter.isActive()) {
+          if (!pdfPainter.begin(pdfWriter.get())) {
+            qCritical() << "Couldn't write to" << m_output;
+            qDeleteAll(docs);
+            return false;
+          }
+        } else {
+          pdfWriter->newPage();
+        }
+
+        drawPage(doc, &pdfPainter);
+      }
+
+      qDeleteAll(docs);
+    }
+
+    out << "\r" << last - m_firstPage + 1 << "/" << total << " pages"
+        << Qt::flush;
+  }
+
+  if (pdfPainter.isActive())
+    pdfPainter.end();
+
+  qreal seconds = std::max<qint64>(1, timer.elapsed()) / 1000.0;
+  out << "\n"
+      << "exported " << total << " pages in " << seconds << "s ("
+      << total / seconds << " pages/s)" << Qt::endl;
+
+  return exported;
+}
+
+void
+PageExporter::drawPage(QTextDocument* doc, QPainter* painter) const
+{
+  QAbstractTextDocumentLayout::PaintContext context;
+  context.palette = m_palette;
+
+  painter->save();
+  painter->setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing |
+                          QPainter::SmoothPixmapTransform);
+  painter->scale(m_scale, m_scale);
+  doc->documentLayout()->draw(painter, context);
+  painter->restore();
+}
+
+bool
+PageExporter::exportPng(QuranPageBrowser* browser) const
+{
+  QTextDocument* doc = browser->buildPageDocument();
+  doc->setTextWidth(doc->idealWidth());
+
+  QImage image(scaledSize(doc), QImage::Format_ARGB32_Premultiplied);
+  image.setDotsPerMeterX(qRound(m_dpi / 0.0254));
+  image.setDotsPerMeterY(qRound(m_dpi / 0.0254));
+  image.fill(m_palette.color(QPalette::Window));
+
+  QPainter painter(&image);
+  drawPage(doc, &painter);
+  painter.end();
+  delete doc;
+
+  QString path = pngPath(browser->page());
+  if (!image.save(path, "PNG")) {
+    qCritical() << "Couldn't save page image" << path;
+    return false;
+  }
+
+  return true;
+}
+
+QTextDocument*
+PageExporter::layoutPdfPage(QuranPageBrowser* browser) const
+{
+  QTextDocument* doc = browser->buildPageDocument();
+  doc->setTextWidth(doc->idealWidth());
+  doc->size(); // finish the layout in the worker thread
+  doc->moveToThread(m_host.thread());
+
+  return doc;
+}
+
+QSize
+PageExporter::scaledSize(QTextDocument* doc) const
+{
+  return (doc->size() * m_scale).toSize();
+}
+
+QString
+PageExporter::pngPath(int page) const
+{
+  return QDir(m_output).filePath(
+    QString("page_%0.png").arg(page, 3, 10, QChar('0')));
+}
@@ -0,0 +1,114 @@
+/**
+ * @file pageexporter.h
+ * @brief Header file for PageExporter
+ */
+
+#ifndef PAGEEXPORTER_H
+#define PAGEEXPORTER_H
+
+#include <QDir>
+#include <QList>
+#include <QPalette>
+#include <QPointer>
+#include <QTextDocument>
+#include <QWidget>
+#include <widgets/quranpagebrowser.h>
+
+/**
+ * @brief PageExporter class renders a range of Quran pages to PNG images or a
+ * single PDF file without showing any window
+ * @details pages are constructed with QuranPageBrowser in batches, page data
+ * is loaded in the GUI thread and the page documents are built and rendered
+ * in the global thread pool. Each batch is written to disk before the next one
+ * is constructed so memory use does not grow with the page range
+ */
+class PageExporter
+{
+public:
+  /**
+   * @brief Format enum represents the supported export formats
+   */
+  enum Format
+  {
+    Png, ///< a PNG image per page in the output directory
+    Pdf  ///< a single PDF file with a PDF page per page
+  };
+  /**
+   * @brief class constructor
+   * @param firstPage - first page to export
+   * @param lastPage - last page to export
+   * @param format - PageExporter::Format to export to
+   * @param dpi - output resolution in dots per inch
+   * @param output - output directory for PNG images, output file for PDF
+   */
+  PageExporter(int firstPage,
+               int lastPage,
+               Format format,
+               int dpi,
+               const QString& output);
+  /**
+   * @brief export the page range, progress and the final pages/second rate
+   * are printed to stdout
+   * @return boolean indicating whether all the pages were exported
+   */
+  bool run();
+
+private:
+  /**
+   * @brief lay out the page document and draw it scaled to the output
+   * resolution
+   * @param doc - page document to draw
+   * @param painter - QPainter to draw the document with
+   */
+  void drawPage(QTextDocument* doc, QPainter* painter) const;
+  /**
+   * @brief build, render and save the PNG image of the page prepared in the
+   * browser, called from worker threads
+   * @param browser - QuranPageBrowser with a prepared page
+   * @return boolean indicating whether the image was saved
+   */
+  bool exportPng(QuranPageBrowser* browser) const;
+  /**
+   * @brief build and lay out the document of the page prepared in the browser
+   * and move it to the GUI thread to be drawn in the PDF, called from worker
+   * threads
+   * @param browser - QuranPageBrowser with a prepared page
+   * @return pointer to the laid out QTextDocument
+   */
+  QTextDocument* layoutPdfPage(QuranPageBrowser* browser) const;
+  /**
+   * @brief size of the given page document scaled to the output resolution
+   * @param doc - laid out page document
+   * @return QSize of the page in output pixels
+   */
+  QSize scaledSize(QTextDocument* doc) const;
+  /**
+   * @brief PNG image path of the given page
+   * @param page - page number
+   * @return QString of the image path in the output directory
+   */
+  QString pngPath(int page) const;
+  const int m_firstPage;
+  const int m_lastPage;
+  const Format m_format;
+  const int m_dpi;
+  /**
+   * @brief scale from the 96 dpi logical page size to the output resolution
+   */
+  const qreal m_scale;
+  const QString m_output;
+  /**
+   * @brief palette captured in the GUI thread for drawing in worker threads
+   */
+  const QPalette m_palette;
+  /**
+   * @brief hidden parent widget of the page browsers
+   */
+  QWidget m_host;
+  /**
+   * @brief page browsers used in constructing a batch of pages
+   */
+  QList<QuranPageBrowser*> m_browsers;
+};
+
+#endif // PAGEEXPORTER_H
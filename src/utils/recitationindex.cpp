@@ -0,0 +1,195 @@
+/**
+ * @file recitationindex.cpp
+ * @brief Implementation file for RecitationIndex
+ */
+
+#include "recitationindex.h"
+#include <QDir>
+#include <QFileInfo>
+#include <types/verse.h>
+#include <utils/dirmanager.h>
+
+RecitationIndex&
+RecitationIndex::getInstance()
+{
+  static RecitationIndex index;
+  return index;
+}
+
+RecitationIndex::RecitationIndex()
+  : m_reciters(Reciter::reciters)
+{
+  Reciter::populateReciters();
+  m_inventories.resize(m_reciters.size());
+
+  int id = 1;
+  for (int surah = 1; surah <= 114; surah++) {
+    m_firstIds[surah - 1] = id;
+    id += Verse::surahVerseCount(surah);
+  }
+
+  m_rescanTimer.setSingleShot(true);
+  m_rescanTimer.setInterval(500);
+  connect(&m_rescanTimer,
+          &QTimer::timeout,
+          this,
+          &RecitationIndex::rescanChanged);
+  connect(&m_watcher,
+          &QFileSystemWatcher::directoryChanged,
+          this,
+          &RecitationIndex::reciterDirChanged);
+}
+
+RecitationIndex::Inventory&
+RecitationIndex::inventory(int reciter)
+{
+  Inventory& inv = m_inventories[reciter];
+  if (!inv.scanned) {
+    scan(reciter);
+
+    QString path = DirManager::getInstance().downloadsDir().absoluteFilePath(
+      "recitations/" + m_reciters.at(reciter).baseDirName());
+    if (m_watcher.addPath(path))
+      m_reciterDirs.insert(path, reciter);
+  }
+
+  return inv;
+}
+
+void
+RecitationIndex::scan(int reciter)
+{
+  const Reciter& r = m_reciters.at(reciter);
+  QDir dir(DirManager::getInstance().downloadsDir().absoluteFilePath(
+    "recitations/" + r.baseDirName()));
+
+  Inventory& inv = m_inventories[reciter];
+  inv.scanned = true;
+  inv.basmallah = QFileInfo::exists(r.basmallahPath());
+  inv.verses = QBitArray(6236);
+  inv.packed = QBitArray(114);
+  inv.surahCounts.fill(0);
+
+  // verse files are named by the padded surah & verse numbers, e.g. 002005.mp3
+  // and packs by the padded surah number, e.g. 002.pack
+  const QStringList files = dir.entryList({ "*.mp3", "*.pack" }, QDir::Files);
+  for (const QString& file : files) {
+    if (file.size() == 8 && file.endsWith(".pack")) {
+      int surah = QStringView(file).left(3).toInt();
+      if (surah < 1 || surah > 114)
+        continue;
+
+      inv.packed.setBit(surah - 1);
+      for (int verse = 1; verse <= Verse::surahVerseCount(surah); verse++)
+        setVerse(inv, surah, verse);
+      continue;
+    }
+
+    if (file.size() != 10)
+      continue;
+
+    bool surahOk, verseOk;
+    int surah = QStringView(file).mid(0, 3).toInt(&surahOk);
+    int verse = QStringView(file).mid(3, 3).toInt(&verseOk);
+    if (surahOk && verseOk)
+      setVerse(inv, surah, verse);
+  }
+}
+
+bool
+RecitationIndex::setVerse(Inventory& inv, int surah, int verse)
+{
+  if (verse < 1 || verse > Verse::surahVerseCount(surah))
+    return false;
+
+  int bit = m_firstIds[surah - 1] + verse - 2;
+  if (inv.verses.testBit(bit))
+    return false;
+
+  inv.verses.setBit(bit);
+  inv.surahCounts[surah - 1]++;
+  return true;
+}
+
+bool
+RecitationIndex::hasVerse(int reciter, int surah, int verse)
+{
+  if (reciter < 0 || reciter >= m_inventories.size() || verse < 1 ||
+      verse > Verse::surahVerseCount(surah))
+    return false;
+
+  return inventory(reciter).verses.testBit(m_firstIds[surah - 1] + verse - 2);
+}
+
+bool
+RecitationIndex::hasBasmallah(int reciter)
+{
+  if (reciter < 0 || reciter >= m_inventories.size())
+    return false;
+
+  return inventory(reciter).basmallah;
+}
+
+int
+RecitationIndex::downloadedVerses(int reciter, int surah)
+{
+  if (reciter < 0 || reciter >= m_inventories.size() || surah < 1 ||
+      surah > 114)
+    return 0;
+
+  return inventory(reciter).surahCounts[surah - 1];
+}
+
+bool
+RecitationIndex::isSurahComplete(int reciter, int surah)
+{
+  int total = Verse::surahVerseCount(surah);
+  return total && downloadedVerses(reciter, surah) == total;
+}
+
+bool
+RecitationIndex::isPacked(int reciter, int surah)
+{
+  if (reciter < 0 || reciter >= m_inventories.size() || surah < 1 ||
+      surah > 114)
+    return false;
+
+  return inventory(reciter).packed.testBit(surah - 1);
+}
+
+void
+RecitationIndex::markDownloaded(int reciter, int surah, int verse)
+{
+  if (reciter < 0 || reciter >= m_inventories.size())
+    return;
+
+  if (setVerse(inventory(reciter), surah, verse))
+    emit changed(reciter);
+}
+
+void
+RecitationIndex::reciterDirChanged(const QString& path)
+{
+  auto it = m_reciterDirs.constFind(path);
+  if (it == m_reciterDirs.cend())
+    return;
+
+  m_changed.insert(it.value());
+  m_rescanTimer.start();
+}
+
+void
+RecitationIndex::rescanChanged()
+{
+  for (int reciter : std::as_const(m_changed)) {
+    Inventory before = m_inventories.at(reciter);
+    scan(reciter);
+
+    const Inventory& after = m_inventories.at(reciter);
+    if (after.verses != before.verses || after.packed != before.packed ||
+        after.basmallah != before.basmallah)
+      emit changed(reciter);
+  }
+
+  m_changed.clear();
+}
@@ -0,0 +1,166 @@
+/**
+ * @file recitationindex.h
+ * @brief Header file for RecitationIndex
+ */
+
+#ifndef RECITATIONINDEX_H
+#define RECITATIONINDEX_H
+
+#include <QBitArray>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <array>
+#include <types/reciter.h>
+
+/**
+ * @brief RecitationIndex class keeps an in-memory inventory of the downloaded
+ * verse recitations of each reciter so availability checks don't touch the
+ * file system
+ * @details a reciter directory is listed once on the first query for the
+ * reciter and watched afterwards, changes made outside the app are picked up
+ * by rescanning the changed directory. Downloads mark their files as soon as
+ * they are written. The index lives in the GUI thread
+ */
+class RecitationIndex : public QObject
+{
+  Q_OBJECT
+public:
+  /**
+   * @brief get a reference to the single class instance
+   * @return reference to the static class instance
+   */
+  static RecitationIndex& getInstance();
+  /**
+   * @brief check whether the recitation of the given verse is downloaded
+   * @param reciter - index of the reciter in Reciter::reciters
+   * @param surah - surah number
+   * @param verse - verse number in the surah
+   * @return boolean indicating whether the verse file exists
+   */
+  bool hasVerse(int reciter, int surah, int verse);
+  /**
+   * @brief check whether the basmallah recitation of the reciter exists
+   * @param reciter - index of the reciter in Reciter::reciters
+   * @return boolean indicating whether the basmallah file exists
+   */
+  bool hasBasmallah(int reciter);
+  /**
+   * @brief get the number of downloaded verses of the given surah
+   * @param reciter - index of the reciter in Reciter::reciters
+   * @param surah - surah number
+   * @return number of verse files of the surah in the reciter directory
+   */
+  int downloadedVerses(int reciter, int surah);
+  /**
+   * @brief check whether all the verses of the given surah are downloaded
+   * @param reciter - index of the reciter in Reciter::reciters
+   * @param surah - surah number
+   * @return boolean indicating whether the surah is complete
+   */
+  bool isSurahComplete(int reciter, int surah);
+  /**
+   * @brief check whether the verses of the given surah are packed in a single
+   * file, see RecitationPack
+   * @param reciter - index of the reciter in Reciter::reciters
+   * @param surah - surah number
+   * @return boolean indicating whether the surah pack exists
+   */
+  bool isPacked(int reciter, int surah);
+  /**
+   * @brief mark the given verse as downloaded, called once the downloaded
+   * file is written
+   * @param reciter - index of the reciter in Reciter::reciters
+   * @param surah - surah number
+   * @param verse - verse number in the surah
+   */
+  void markDownloaded(int reciter, int surah, int verse);
+
+signals:
+  /**
+   * @brief emitted when the inventory of a reciter changes
+   * @param reciter - index of the reciter in Reciter::reciters
+   */
+  void changed(int reciter);
+
+private:
+  RecitationIndex();
+  /**
+   * @brief Inventory struct holds the downloaded files of a single reciter
+   */
+  struct Inventory
+  {
+    bool scanned = false;
+    bool basmallah = false;
+    /**
+     * @brief bit for each verse in the Quran, indexed by the verse id - 1
+     */
+    QBitArray verses;
+    /**
+     * @brief bit for each packed surah, indexed by the surah number - 1
+     */
+    QBitArray packed;
+    /**
+     * @brief number of downloaded verses in each surah
+     */
+    std::array<quint16, 114> surahCounts{};
+  };
+  /**
+   * @brief get the inventory of the reciter, the reciter directory is scanned
+   * on the first call
+   * @param reciter - index of the reciter in Reciter::reciters
+   * @return reference to the reciter Inventory
+   */
+  Inventory& inventory(int reciter);
+  /**
+   * @brief list the reciter directory and rebuild its inventory
+   * @param reciter - index of the reciter in Reciter::reciters
+   */
+  void scan(int reciter);
+  /**
+   * @brief set the bit of the given verse and update the surah count
+   * @param inv - Inventory to update
+   * @param surah - surah number
+   * @param verse - verse number in the surah
+   * @return boolean indicating whether the bit was changed
+   */
+  bool setVerse(Inventory& inv, int surah, int verse);
+  /**
+   * @brief callback for changes in the watched reciter directories, rescans
+   * are batched since downloads change the directory for every verse
+   * @param path - absolute path of the changed directory
+   */
+  void reciterDirChanged(const QString& path);
+  /**
+   * @brief rescan the reciter directories changed since the last rescan
+   */
+  void rescanChanged();
+  /**
+   * @brief reference to the reciters list
+   */
+  const QList<Reciter>& m_reciters;
+  /**
+   * @brief id of the first verse of each surah, used to map a verse to its
+   * bit without summing the verse counts
+   */
+  std::array<int, 114> m_firstIds;
+  /**
+   * @brief inventories by reciter index
+   */
+  QList<Inventory> m_inventories;
+  /**
+   * @brief reciter indices by their absolute directory path
+   */
+  QHash<QString, int> m_reciterDirs;
+  /**
+   * @brief reciters whose directories changed since the last rescan
+   */
+  QSet<int> m_changed;
+  QTimer m_rescanTimer;
+  QFileSystemWatcher m_watcher;
+};
+
+#endif // RECITATIONINDEX_H
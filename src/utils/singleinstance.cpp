@@ -0,0 +1,114 @@
+/**
+ * @file singleinstance.cpp
+ * @brief Implementation file for SingleInstance
+ */
+
+#include "singleinstance.h"
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QLocalSocket>
+#include <utils/dirmanager.h>
+
+SingleInstance&
+SingleInstance::getInstance()
+{
+  static SingleInstance instance;
+  return instance;
+}
+
+SingleInstance::SingleInstance()
+  : m_serverName(
+      "QuranCompanion-" +
+      QCryptographicHash::hash(
+        DirManager::getInstance().configDir().absolutePath().toUtf8(),
+        QCryptographicHash::Sha1)
+        .toHex()
+        .left(16))
+{
+}
+
+bool
+SingleInstance::forward(const QJsonObject& request)
+{
+  QLocalSocket socket;
+  socket.connectToServer(m_serverName);
+  if (!socket.waitForConnected(200))
+    return false;
+
+  socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+  if (!socket.waitForBytesWritten(1000)) {
+    qWarning() << "Couldn't forward request to the running instance:"
+               << socket.errorString();
+    return false;
+  }
+
+  socket.disconnectFromServer();
+  return true;
+}
+
+bool
+SingleInstance::listen()
+{
+  if (m_server != nullptr)
+    return m_server->isListening();
+
+  m_server = new QLocalServer(this);
+  m_server->setSocketOptions(QLocalServer::UserAccessOption);
+  connect(m_server,
+          &QLocalServer::newConnection,
+          this,
+          &SingleInstance::acceptConnection);
+
+  // a socket left behind by a crashed instance is removed and reused
+  if (!m_server->listen(m_serverName) &&
+      m_server->serverError() == QAbstractSocket::AddressInUseError) {
+    QLocalServer::removeServer(m_serverName);
+    m_server->listen(m_serverName);
+  }
+
+  if (!m_server->isListening()) {
+    qWarning() << "Single instance server not started:"
+               << m_server->errorString();
+    return false;
+  }
+
+  return true;
+}
+
+void
+SingleInstance::close()
+{
+  if (m_server != nullptr)
+    m_server->close();
+}
+
+void
+SingleInstance::acceptConnection()
+{
+  while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+    connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+      readRequests(socket);
+    });
+    // the invocation may disconnect before its request is read
+    connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+      readRequests(socket);
+      socket->deleteLater();
+    });
+  }
+}
+
+void
+SingleInstance::readRequests(QLocalSocket* socket)
+{
+  while (socket->canReadLine()) {
+    QJsonParseError error;
+    QJsonDocument doc =
+      QJsonDocument::fromJson(socket->readLine().trimmed(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+      qWarning() << "Invalid instance request:" << error.errorString();
+      continue;
+    }
+
+    emit requestReceived(doc.object());
+  }
+}
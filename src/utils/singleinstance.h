@@ -0,0 +1,74 @@
+/**
+ * @file singleinstance.h
+ * @brief Header file for SingleInstance
+ */
+
+#ifndef SINGLEINSTANCE_H
+#define SINGLEINSTANCE_H
+
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QPointer>
+
+/**
+ * @brief SingleInstance class keeps a single running instance of the app per
+ * user by listening on a local socket
+ * @details a new invocation forwards its command line request to the running
+ * instance as a JSON object on a single line and exits before loading
+ * anything. The request may contain a "verse" ("surah:ayah"), a "page", a
+ * "find" search term and a "play" flag
+ */
+class SingleInstance : public QObject
+{
+  Q_OBJECT
+public:
+  /**
+   * @brief get a reference to the single class instance
+   * @return reference to the static class instance
+   */
+  static SingleInstance& getInstance();
+  /**
+   * @brief forward the request to the running instance if there is one
+   * @param request - QJsonObject of the command line request
+   * @return boolean indicating whether a running instance received the request
+   */
+  bool forward(const QJsonObject& request);
+  /**
+   * @brief start listening for requests from new invocations
+   * @return boolean indicating whether the server is listening
+   */
+  bool listen();
+  /**
+   * @brief stop listening, used before starting a replacement instance
+   */
+  void close();
+
+signals:
+  /**
+   * @brief emitted when a request is received from a new invocation
+   * @param request - QJsonObject of the forwarded request
+   */
+  void requestReceived(const QJsonObject& request);
+
+private:
+  SingleInstance();
+  /**
+   * @brief read the request from a newly connected invocation
+   */
+  void acceptConnection();
+  /**
+   * @brief emit requestReceived() for each complete request line
+   * @param socket - QLocalSocket of the connected invocation
+   */
+  void readRequests(QLocalSocket* socket);
+  /**
+   * @brief local socket name, derived from the config directory so instances
+   * with a different config directory do not interfere
+   */
+  const QString m_serverName;
+  QPointer<QLocalServer> m_server;
+};
+
+#endif // SINGLEINSTANCE_H
@@ -0,0 +1,124 @@
+/**
+ * @file startupreport.cpp
+ * @brief Implementation file for StartupReport
+ */
+
+#include "startupreport.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QThread>
+
+StartupReport&
+StartupReport::getInstance()
+{
+  static StartupReport report;
+  return report;
+}
+
+StartupReport::StartupReport()
+{
+  m_clock.start();
+}
+
+StartupReport::Phase::Phase(const QString& name)
+  : m_idx(-1)
+{
+  StartupReport& report = StartupReport::getInstance();
+  if (!report.recording())
+    return;
+
+  m_idx = report.m_entries.size();
+  report.m_entries.append(
+    { name, report.m_depth, report.m_clock.nsecsElapsed(), -1 });
+  report.m_depth++;
+}
+
+StartupReport::Phase::~Phase()
+{
+  end();
+}
+
+void
+StartupReport::Phase::end()
+{
+  if (m_idx == -1)
+    return;
+
+  StartupReport& report = StartupReport::getInstance();
+  Entry& entry = report.m_entries[m_idx];
+  entry.durationNs = report.m_clock.nsecsElapsed() - entry.startNs;
+  report.m_depth--;
+  m_idx = -1;
+}
+
+bool
+StartupReport::recording() const
+{
+  // phases are only recorded in the GUI thread, the instance may not exist
+  // yet for the phases running before QApplication
+  QCoreApplication* app = QCoreApplication::instance();
+  return !m_finished && (!app || QThread::currentThread() == app->thread());
+}
+
+void
+StartupReport::setJsonPath(const QString& path)
+{
+  m_jsonPath = path;
+}
+
+void
+StartupReport::finish()
+{
+  if (m_finished)
+    return;
+
+  m_finished = true;
+  qint64 totalNs = m_clock.nsecsElapsed();
+
+  qInfo().noquote() << "Startup report:";
+  for (const Entry& e : m_entries) {
+    qInfo().noquote() << QString("%0%1 %2 ms (at %3 ms)")
+                           .arg(QString(e.depth * 2, ' '))
+                           .arg(e.name.leftJustified(40 - e.depth * 2, '.'))
+                           .arg(e.durationNs / 1e6, 0, 'f', 2)
+                           .arg(e.startNs / 1e6, 0, 'f', 2);
+  }
+  qInfo().noquote() << QString("Startup finished in %0 ms")
+                         .arg(totalNs / 1e6, 0, 'f', 2);
+
+  if (!m_jsonPath.isEmpty())
+    writeJson(totalNs);
+}
+
+void
+StartupReport::writeJson(qint64 totalNs) const
+{
+  QJsonArray phases;
+  for (const Entry& e : m_entries) {
+    QJsonObject phase;
+    phase["name"] = e.name;
+    phase["depth"] = e.depth;
+    phase["start_ms"] = e.startNs / 1e6;
+    phase["duration_ms"] = e.durationNs / 1e6;
+    phases.append(phase);
+  }
+
+  QJsonObject report;
+  report["version"] = QCoreApplication::applicationVersion();
+  report["os"] = QSysInfo::prettyProductName();
+  report["cpu"] = QSysInfo::currentCpuArchitecture();
+  report["total_ms"] = totalNs / 1e6;
+  report["phases"] = phases;
+
+  QFile file(m_jsonPath);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << "Couldn't write startup report to" << m_jsonPath;
+    return;
+  }
+
+  file.write(QJsonDocument(report).toJson());
+}
@@ -0,0 +1,102 @@
+/**
+ * @file startupreport.h
+ * @brief Header file for StartupReport
+ */
+
+#ifndef STARTUPREPORT_H
+#define STARTUPREPORT_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+
+/**
+ * @brief StartupReport class records the duration of the application startup
+ * phases and reports them once the main window is shown
+ * @details the clock starts on the first call to getInstance(), phases are
+ * recorded with StartupReport::Phase scopes and may be nested. Phases that end
+ * after the report is finished or run outside the GUI thread are ignored
+ */
+class StartupReport
+{
+public:
+  /**
+   * @brief Phase class is a scope that records a startup phase from its
+   * construction until end() is called or it goes out of scope
+   */
+  class Phase
+  {
+  public:
+    /**
+     * @brief start recording a phase
+     * @param name - phase name shown in the report
+     */
+    explicit Phase(const QString& name);
+    ~Phase();
+    /**
+     * @brief end the phase before the end of the scope
+     */
+    void end();
+
+  private:
+    /**
+     * @brief index of the phase entry in the report, -1 if not recorded
+     */
+    int m_idx;
+  };
+  /**
+   * @brief get a reference to the single class instance
+   * @return reference to the static class instance
+   */
+  static StartupReport& getInstance();
+  /**
+   * @brief set the path of the JSON report file, the JSON report is only
+   * written if a path is set
+   * @param path - file path to write the JSON report to
+   */
+  void setJsonPath(const QString& path);
+  /**
+   * @brief stop recording and emit the report to the log, and to the JSON
+   * file if set
+   */
+  void finish();
+
+private:
+  StartupReport();
+  /**
+   * @brief Entry struct holds a single recorded phase
+   */
+  struct Entry
+  {
+    QString name;
+    int depth;
+    qint64 startNs;
+    qint64 durationNs;
+  };
+  /**
+   * @brief check whether phases are currently being recorded
+   * @return boolean indicating whether the calling thread may record phases
+   */
+  bool recording() const;
+  /**
+   * @brief write the JSON report to m_jsonPath
+   * @param totalNs - total startup time in nanoseconds
+   */
+  void writeJson(qint64 totalNs) const;
+  /**
+   * @brief monotonic clock started with the process
+   */
+  QElapsedTimer m_clock;
+  /**
+   * @brief recorded phases in the order they started
+   */
+  QList<Entry> m_entries;
+  /**
+   * @brief nesting depth of the currently running phase
+   */
+  int m_depth = 0;
+  bool m_finished = false;
+  QString m_jsonPath;
+};
+
+#endif // STARTUPREPORT_H
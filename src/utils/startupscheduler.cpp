@@ -0,0 +1,54 @@
+/**
+ * @file startupscheduler.cpp
+ * @brief Implementation file for StartupScheduler
+ */
+
+#include "startupscheduler.h"
+#include <utils/startupreport.h>
+
+StartupScheduler&
+StartupScheduler::getInstance()
+{
+  static StartupScheduler scheduler;
+  return scheduler;
+}
+
+StartupScheduler::StartupScheduler()
+{
+  m_idleTimer.setSingleShot(true);
+  m_idleTimer.setInterval(0);
+  connect(&m_idleTimer, &QTimer::timeout, this, &StartupScheduler::runNext);
+}
+
+void
+StartupScheduler::defer(const QString& name, std::function<void()> task)
+{
+  m_tasks.enqueue({ name, std::move(task) });
+  if (m_started && !m_idleTimer.isActive())
+    m_idleTimer.start();
+}
+
+void
+StartupScheduler::start()
+{
+  if (m_started)
+    return;
+
+  m_started = true;
+  m_idleTimer.start();
+}
+
+void
+StartupScheduler::runNext()
+{
+  if (!m_tasks.isEmpty()) {
+    Task task = m_tasks.dequeue();
+    StartupReport::Phase phase(task.name);
+    task.run();
+  }
+
+  if (m_tasks.isEmpty())
+    emit finished();
+  else
+    m_idleTimer.start();
+}
@@ -0,0 +1,73 @@
+/**
+ * @file startupscheduler.h
+ * @brief Header file for StartupScheduler
+ */
+
+#ifndef STARTUPSCHEDULER_H
+#define STARTUPSCHEDULER_H
+
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <QTimer>
+#include <functional>
+
+/**
+ * @brief StartupScheduler class runs the startup work that is not needed for
+ * the first page in stages after the main window is shown
+ * @details deferred tasks run in the order they were added, one task per event
+ * loop iteration so input and paint events are handled in between. Each task
+ * is recorded as a StartupReport phase
+ */
+class StartupScheduler : public QObject
+{
+  Q_OBJECT
+public:
+  /**
+   * @brief get a reference to the single class instance
+   * @return reference to the static class instance
+   */
+  static StartupScheduler& getInstance();
+  /**
+   * @brief add a task to run once the event loop is idle, tasks deferred after
+   * start() are run as soon as the previous tasks are done
+   * @param name - task name shown in the startup report
+   * @param task - function to run in the GUI thread
+   */
+  void defer(const QString& name, std::function<void()> task);
+  /**
+   * @brief start running the deferred tasks, should be called after the main
+   * window is shown
+   */
+  void start();
+
+signals:
+  /**
+   * @brief emitted once all the deferred tasks are done
+   */
+  void finished();
+
+private:
+  StartupScheduler();
+  /**
+   * @brief Task struct holds a single deferred task
+   */
+  struct Task
+  {
+    QString name;
+    std::function<void()> run;
+  };
+  /**
+   * @brief run the next deferred task and schedule the one after it
+   */
+  void runNext();
+  /**
+   * @brief zero interval single shot timer that fires when the event loop is
+   * done with the pending events
+   */
+  QTimer m_idleTimer;
+  QQueue<Task> m_tasks;
+  bool m_started = false;
+};
+
+#endif // STARTUPSCHEDULER_H
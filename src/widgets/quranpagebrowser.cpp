@@ -4,21 +4,25 @@
  */
 
 #include "quranpagebrowser.h"
+#include <QAbstractTextDocumentLayout>
 #include <QApplication>
 #include <QRegularExpression>
+#include <QSet>
+#include <QTextBlock>
 #include <QtAwesome.h>
+#include <algorithm>
 #include <service/servicefactory.h>
 #include <utils/fontmanager.h>
 using namespace fa;
 
 QuranPageBrowser::QuranPageBrowser(QWidget* parent, int initPage)
   : QTextBrowser(parent)
-  , m_highlighter(new QTextCursor(document()))
   , m_highlightColor(QBrush(qApp->palette().color(QPalette::Highlight)))
   , m_config(Configuration::getInstance())
   , m_styleMgr(StyleManager::getInstance())
   , m_quranService(ServiceFactory::quranService())
   , m_glyphService(ServiceFactory::glyphService())
+  , m_metricsCache(FontMetricsCache::getInstance())
 {
   setOpenLinks(false);
   setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
@@ -27,7 +31,18 @@ QuranPageBrowser::QuranPageBrowser(QWidget* parent, int initPage)
   createActions();
   updateFontSize();
 
+  // resizes arriving within the interval are coalesced into one restyle
+  m_resizeTimer.setSingleShot(true);
+  m_resizeTimer.setInterval(150);
+  connect(&m_resizeTimer,
+          &QTimer::timeout,
+          this,
+          &QuranPageBrowser::adaptToSize);
+
+  FontManager::getInstance().pinPageFont(this, initPage);
   m_pageFont = FontManager::getInstance().getInstance().pageFontname(initPage);
+  m_infoBrush = QBrush(qApp->palette().color(QPalette::PlaceholderText));
+  m_textBrush = qApp->palette().text();
   m_pageFormat.setAlignment(Qt::AlignCenter);
   m_pageFormat.setNonBreakableLines(true);
   m_pageFormat.setLayoutDirection(Qt::RightToLeft);
@@ -47,7 +62,6 @@ QuranPageBrowser::updateFontSize()
 QSize
 QuranPageBrowser::calcPageLineSize(QStringList& lines)
 {
-  QFontMetrics fm(QFont(m_pageFont, m_fontSize));
   QString measureLine;
   if (m_page < 3) {
     measureLine = lines.at(3);
@@ -57,11 +71,44 @@ QuranPageBrowser::calcPageLineSize(QStringList& lines)
     measureLine = lines.at(lines.size() - 2);
   }
 
-  return fm.size(Qt::TextSingleLine, measureLine.remove(':')) + QSize(0, 5);
+  return m_metricsCache.pageLineSize(QFont(m_pageFont, m_fontSize),
+                                     m_page,
+                                     measureLine.remove(':')) +
+         QSize(0, 5);
+}
+
+const QImage&
+QuranPageBrowser::pageImage(const QString& name)
+{
+  auto it = m_pageImages.constFind(name);
+  if (it != m_pageImages.cend())
+    return *it;
+
+  QImage image;
+  if (name == "bsml") {
+    image.load(":/resources/basmalah.png");
+    if (m_config.darkMode())
+      image.invertPixels();
+  } else {
+    image = surahFrame(m_surahNameGlyphs.value(name.split('_').at(1).toInt()));
+  }
+
+  return *m_pageImages.insert(name, image);
+}
+
+void
+QuranPageBrowser::addPageImageResource(QTextDocument* doc, const QString& name)
+{
+  // surah frames are slightly wider than the page lines
+  int width = m_pageLineSize.width() + (name == "bsml" ? 0 : 5);
+  doc->addResource(
+    QTextDocument::ImageResource,
+    QUrl(name),
+    m_pageImages.value(name).scaledToWidth(width, Qt::SmoothTransformation));
 }
 
 QImage
-QuranPageBrowser::surahFrame(int surah)
+QuranPageBrowser::surahFrame(const QString& nameGlyph)
 {
   QImage baseImage(":/resources/sura_box.png"); // load the empty frame
 
@@ -69,7 +116,7 @@ QuranPageBrowser::surahFrame(int surah)
   QString frmText;
   frmText.append("ﰦ");
   frmText.append("ﮌ");
-  frmText.append(m_glyphService->getSurahNameGlyph(surah));
+  frmText.append(nameGlyph);
 
   // draw on top of the image the surah name text
   QPainter p(&baseImage);
@@ -99,46 +146,50 @@ QuranPageBrowser::setHref(QTextCursor* cursor, int to, QString url)
 }
 
 void
-QuranPageBrowser::insertFooter(QTextCursor* cursor, int page)
+QuranPageBrowser::insertFooter(QTextCursor* cursor)
 {
-  m_pageInfoTextFormat.setFontPointSize(m_fontSize - 6);
-
-  cursor->insertBlock(m_pageFormat, m_pageInfoTextFormat);
-  QFontMetrics fm(m_pageInfoTextFormat.font());
-
-  // first -> rub no. relative to hizb
-  // second -> hizb no.
-  std::optional<QPair<int, int>> rubStartingInPage =
-    m_quranService->getRubStartingInPage(page);
-  m_currFooterSegments = this->pageFooter(m_page, rubStartingInPage);
+  QTextCharFormat format = m_pageInfoTextFormat;
+  format.setFontPointSize(m_fontSize - 6);
+  cursor->insertBlock(m_pageFormat, format);
+  fillFooter(cursor);
+}
 
-  if (rubStartingInPage.has_value()) {
-    int rubWidth = fm.horizontalAdvance(m_currFooterSegments.at(0));
-    int pageNumWidth = fm.horizontalAdvance(m_currFooterSegments.at(1));
-    int hizbWidth = fm.horizontalAdvance(m_currFooterSegments.at(2));
+void
+QuranPageBrowser::fillFooter(QTextCursor* cursor)
+{
+  QTextCharFormat format = m_pageInfoTextFormat;
+  format.setFontPointSize(m_fontSize - 6);
+  QFont font = format.font();
+
+  // rub & hizb segments surround the page number when a rub starts in the page
+  if (m_currFooterSegments.size() == 3) {
+    int rubWidth =
+      m_metricsCache.horizontalAdvance(font, m_currFooterSegments.at(0));
+    int pageNumWidth =
+      m_metricsCache.horizontalAdvance(font, m_currFooterSegments.at(1));
+    int hizbWidth =
+      m_metricsCache.horizontalAdvance(font, m_currFooterSegments.at(2));
 
     int remaining =
       m_pageLineSize.width() - rubWidth - hizbWidth - pageNumWidth;
-    int spaceCount = remaining / fm.horizontalAdvance(' ');
+    int spaceCount = remaining / m_metricsCache.spaceAdvance(font);
 
-    m_pageInfoTextFormat.setForeground(
-      QBrush(qApp->palette().color(QPalette::PlaceholderText)));
-    cursor->setCharFormat(m_pageInfoTextFormat);
+    format.setForeground(m_infoBrush);
+    cursor->setCharFormat(format);
     cursor->insertText(m_currFooterSegments.at(0));
 
-    m_pageInfoTextFormat.setForeground(qApp->palette().text());
-    cursor->setCharFormat(m_pageInfoTextFormat);
+    format.setForeground(m_textBrush);
+    cursor->setCharFormat(format);
     cursor->insertText(QString(spaceCount / 2, ' ') +
                        m_currFooterSegments.at(1) +
                        QString((spaceCount + 1) / 2, ' '));
 
-    m_pageInfoTextFormat.setForeground(
-      QBrush(qApp->palette().color(QPalette::PlaceholderText)));
-    cursor->setCharFormat(m_pageInfoTextFormat);
+    format.setForeground(m_infoBrush);
+    cursor->setCharFormat(format);
     cursor->insertText(m_currFooterSegments.at(2));
   } else {
-    m_pageInfoTextFormat.setForeground(qApp->palette().text());
-    cursor->setCharFormat(m_pageInfoTextFormat);
+    format.setForeground(m_textBrush);
+    cursor->setCharFormat(format);
     cursor->insertText(m_currFooterSegments.at(0));
   }
 }
@@ -158,11 +209,19 @@ QuranPageBrowser::pageHeader(int page)
 }
 
 int
-QuranPageBrowser::insertHeader(QTextCursor* cursor, int page)
+QuranPageBrowser::insertHeader(QTextCursor* cursor)
+{
+  cursor->insertBlock(m_pageFormat, m_pageInfoTextFormat);
+  cursor->insertText(m_currHeaderLine);
+
+  setHref(cursor, 1, "#F" + QString::number(m_headerData.first));
+  return m_currHeaderLine.size();
+}
+
+QString
+QuranPageBrowser::headerLine(int page)
 {
-  m_currHeaderSegments = this->pageHeader(m_page);
-  m_pageInfoTextFormat.setForeground(
-    QBrush(qApp->palette().color(QPalette::PlaceholderText)));
+  m_pageInfoTextFormat.setForeground(m_infoBrush);
 
   // smaller header font size for long juz > 10
   if (m_config.qcfVersion() == 1 && page >= 202)
@@ -170,19 +229,16 @@ QuranPageBrowser::insertHeader(QTextCursor* cursor, int page)
   else
     m_pageInfoTextFormat.setFontPointSize(m_fontSize - 6);
 
-  QFontMetrics fm(m_pageInfoTextFormat.font());
-  int juzWidth = fm.horizontalAdvance(m_currHeaderSegments.at(0));
-  int suraWidth = fm.horizontalAdvance(m_currHeaderSegments.at(1));
+  QFont font = m_pageInfoTextFormat.font();
+  int juzWidth =
+    m_metricsCache.horizontalAdvance(font, m_currHeaderSegments.at(0));
+  int suraWidth =
+    m_metricsCache.horizontalAdvance(font, m_currHeaderSegments.at(1));
   int margin = m_config.qcfVersion() == 1 ? 5 : 10;
   int remaining = m_pageLineSize.width() - juzWidth - suraWidth - margin;
-  int spaceCount = remaining / fm.horizontalAdvance(' ');
-
-  QString headerLine = m_currHeaderSegments.join(QString(spaceCount, ' '));
-  cursor->insertBlock(m_pageFormat, m_pageInfoTextFormat);
-  cursor->insertText(headerLine);
+  int spaceCount = remaining / m_metricsCache.spaceAdvance(font);
 
-  setHref(cursor, 1, "#F" + QString::number(m_headerData.first));
-  return headerLine.size();
+  return m_currHeaderSegments.join(QString(spaceCount, ' '));
 }
 
 QStringList
@@ -204,119 +260,240 @@ QuranPageBrowser::pageFooter(int page,
 
 void
 QuranPageBrowser::constructPage(int pageNo, bool forceCustomSize)
+{
+  preparePage(pageNo, forceCustomSize);
+  setPageDocument(buildPageDocument());
+}
+
+void
+QuranPageBrowser::preparePage(int pageNo, bool forceCustomSize)
 {
   if (pageNo != m_page) {
     m_page = pageNo;
     m_highlightedIdx = -1;
   }
-  // cleanup
-  if (!m_verseCoordinates.empty())
-    m_verseCoordinates.clear();
-  this->document()->clear();
+  m_pressedIdx = -1;
 
+  // the font stays registered while the page is displayed
+  FontManager::getInstance().pinPageFont(this, pageNo);
   m_pageFont = FontManager::getInstance().pageFontname(pageNo);
-  QTextCursor textCursor(this->document());
+  FontManager::getInstance().preloadNeighbours(pageNo);
+  m_documentFont = font();
 
   m_currPageLines = m_glyphService->getPageLines(m_page);
 
   // automatic font adjustment check
   if (!forceCustomSize &&
-      m_config.settings().value("Reader/AdaptiveFont").toBool()) {
+      m_config.settings().value("Reader/AdaptiveFont").toBool())
     m_fontSize = this->bestFitFontSize();
-    m_config.settings().setValue(
-      "Reader/QCF" + QString::number(m_config.qcfVersion()) + "Size",
-      m_fontSize);
-  }
 
   m_pageLineSize = this->calcPageLineSize(m_currPageLines);
+  emit minimumPageWidthChanged(minimumPageWidth());
+
+  m_bodyTextFormat.setFont(QFont(m_pageFont, m_fontSize));
 
-  int prevAnchor = 0;
-  // insert header in pages 3-604
+  // header in pages 3-604, the verse bounds start after the header line
+  m_bodyStart = 0;
   if (pageNo > 2) {
-    prevAnchor = this->insertHeader(&textCursor, m_page) + 1;
+    m_currHeaderSegments = this->pageHeader(m_page);
+    m_currHeaderLine = this->headerLine(m_page);
+    m_bodyStart = m_currHeaderLine.size() + 1;
+  }
+
+  // first -> rub no. relative to hizb
+  // second -> hizb no.
+  std::optional<QPair<int, int>> rubStartingInPage =
+    m_quranService->getRubStartingInPage(m_page);
+  m_currFooterSegments = this->pageFooter(m_page, rubStartingInPage);
+
+  QSet<QString> pageImages;
+  for (const QString& l : m_currPageLines) {
+    if (l.contains("bsml"))
+      pageImages.insert("bsml");
+    if (!l.contains("frame"))
+      continue;
+
+    int surah = l.trimmed().split('_').at(1).toInt();
+    if (!m_surahNameGlyphs.contains(surah))
+      m_surahNameGlyphs.insert(surah, m_glyphService->getSurahNameGlyph(surah));
+    pageImages.insert(l.trimmed());
   }
 
-  parentWidget()->setMinimumWidth(m_pageLineSize.width() + 70);
+  // only the images of the prepared page are kept for restyling, they are
+  // generated here so buildPageDocument only reads the cache
+  m_pageImages.removeIf([&pageImages](QHash<QString, QImage>::iterator it) {
+    return !pageImages.contains(it.key());
+  });
+  for (const QString& name : std::as_const(pageImages))
+    pageImage(name);
+
+  // verse bounds are relative to the page body, offset in setPageDocument
+  m_pageVerseBounds = m_glyphService->getVerseCoordinates(m_page);
+}
+
+QTextDocument*
+QuranPageBrowser::buildPageDocument()
+{
+  QTextDocument* doc = new QTextDocument;
+  doc->setUndoRedoEnabled(false);
+  doc->setDefaultFont(m_documentFont);
+  QTextCursor textCursor(doc);
+
+  if (m_page > 2)
+    this->insertHeader(&textCursor);
 
   // page lines drawing
-  int counter = 0;
-  m_bodyTextFormat.setFont(QFont(m_pageFont, m_fontSize));
+  int prevAnchor = m_bodyStart;
   foreach (QString l, m_currPageLines) {
     l = l.trimmed();
     if (l.isEmpty())
       continue;
 
-    if (l.contains("frame")) {
-      // generate frame for surah
-      int surah = l.split('_').at(1).toInt();
-      QImage surahFrame = this->surahFrame(surah);
-      // insert the surah image in the document
-      textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
-      textCursor.insertImage(surahFrame.scaledToWidth(
-        m_pageLineSize.width() + 5, Qt::SmoothTransformation));
-
-      setHref(&textCursor, prevAnchor, "#F" + QString::number(surah));
-      prevAnchor += 2;
-    } else if (l.contains("bsml")) {
-      QImage bsml(":/resources/basmalah.png");
-      if (m_config.darkMode())
-        bsml.invertPixels();
+    if (l.contains("frame") || l.contains("bsml")) {
+      // images are added as named resources to be rescaled in restylePage
+      QString name = l.contains("bsml") ? "bsml" : l;
+      QTextImageFormat imageFormat;
+      imageFormat.setName(name);
+      addPageImageResource(doc, name);
 
       textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
-      textCursor.insertImage(
-        bsml.scaledToWidth(m_pageLineSize.width(), Qt::SmoothTransformation));
-      prevAnchor += 2;
+      textCursor.insertImage(imageFormat);
+
+      // surah frame
+      if (name != "bsml")
+        setHref(&textCursor,
+                prevAnchor,
+                "#F" + QString::number(name.split('_').at(1).toInt()));
+      prevAnchor = textCursor.position();
     } else {
-      // pageline inertion operation
+      // pageline inertion operation, verse separators are not displayed
       textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
-      // if contains verse separator character, add anchors
-      if (l.contains(':')) {
-        foreach (QChar glyph, l) {
-          if (glyph != ':') {
-            textCursor.insertText(glyph);
-          } else {
-            int lastInsertPos =
-              setHref(&textCursor, prevAnchor, "#" + QString::number(counter));
-
-            QPair<int, int> coords(prevAnchor, lastInsertPos);
-            m_verseCoordinates.append(coords);
-
-            counter++;
-            prevAnchor = lastInsertPos;
-          }
-        }
-
-      } else
-        textCursor.insertText(l);
+      textCursor.insertText(l.remove(':'));
+      prevAnchor = textCursor.position();
     }
   }
 
   // insert footer (page number)
-  insertFooter(&textCursor, m_page);
+  insertFooter(&textCursor);
+
+  return doc;
+}
+
+void
+QuranPageBrowser::setPageDocument(QTextDocument* doc)
+{
+  setExtraSelections({});
+
+  // the default document is owned and deleted by the text control
+  QTextDocument* old = document();
+  const bool owned = old->parent() == this;
+  doc->setParent(this);
+  setDocument(doc);
+  if (owned)
+    delete old;
+
+  m_verseCoordinates = m_pageVerseBounds;
+  for (QPair<int, int>& bounds : m_verseCoordinates) {
+    bounds.first += m_bodyStart;
+    bounds.second += m_bodyStart;
+  }
+
   setAlignment(Qt::AlignCenter);
 }
 
+void
+QuranPageBrowser::restylePage(int fontSize)
+{
+  if (m_page < 1 || m_currPageLines.isEmpty())
+    return;
+
+  m_fontSize = fontSize;
+  m_pageLineSize = this->calcPageLineSize(m_currPageLines);
+  emit minimumPageWidthChanged(minimumPageWidth());
+
+  QTextCursor cursor(document());
+  cursor.beginEditBlock();
+
+  // the first block is always empty, content starts at the second one
+  QTextBlock bodyBlock = document()->firstBlock().next();
+  if (m_page > 2) {
+    // header spacing depends on the line width, the verse bounds are shifted
+    // by the change in the header length
+    QTextBlock header = bodyBlock;
+    cursor.setPosition(header.position());
+    cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
+    int oldLength = cursor.selectedText().size();
+    cursor.removeSelectedText();
+
+    QString headerLine = this->headerLine(m_page);
+    cursor.insertText(headerLine, m_pageInfoTextFormat);
+    setHref(&cursor,
+            header.position(),
+            "#F" + QString::number(m_headerData.first));
+
+    int shift = headerLine.size() - oldLength;
+    for (QPair<int, int>& bounds : m_verseCoordinates) {
+      bounds.first += shift;
+      bounds.second += shift;
+    }
+
+    bodyBlock = header.next();
+  }
+
+  // page lines keep their glyphs, only the font size changes, images are
+  // rescaled from the cached full size images
+  QTextBlock footer = document()->lastBlock();
+  for (QTextBlock b = bodyBlock; b.isValid() && b != footer; b = b.next()) {
+    for (QTextBlock::iterator it = b.begin(); !it.atEnd(); ++it) {
+      QTextCharFormat fmt = it.fragment().charFormat();
+      if (fmt.isImageFormat())
+        addPageImageResource(document(), fmt.toImageFormat().name());
+    }
+  }
+
+  QTextCharFormat bodySize;
+  bodySize.setFontPointSize(m_fontSize);
+  m_bodyTextFormat.setFontPointSize(m_fontSize);
+  cursor.setPosition(bodyBlock.position());
+  cursor.setPosition(footer.position() - 1, QTextCursor::KeepAnchor);
+  cursor.mergeCharFormat(bodySize);
+  document()->markContentsDirty(bodyBlock.position(),
+                                footer.position() - bodyBlock.position());
+
+  // footer spacing depends on the line width as well
+  cursor.setPosition(footer.position());
+  cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
+  cursor.removeSelectedText();
+  fillFooter(&cursor);
+
+  cursor.endEditBlock();
+
+  if (m_highlightedIdx != -1)
+    highlightVerse(m_highlightedIdx);
+}
+
 void
 QuranPageBrowser::highlightVerse(int verseIdxInPage)
 {
-  if (verseIdxInPage > m_verseCoordinates.size() || verseIdxInPage < 0) {
+  if (verseIdxInPage >= m_verseCoordinates.size() || verseIdxInPage < 0) {
     qCritical() << "verseIdxInPage is out of page coords range!!!";
     return;
   }
 
-  resetHighlight();
-
-  QTextCharFormat tcf;
+  // the highlight is painted on top of the document as an extra selection,
+  // the document itself is never reformatted
+  QTextEdit::ExtraSelection highlight;
   if (m_fgHighlight)
-    tcf.setForeground(m_highlightColor);
+    highlight.format.setForeground(m_highlightColor);
   else
-    tcf.setBackground(m_highlightColor);
+    highlight.format.setBackground(m_highlightColor);
 
   const QPair<int, int>& bounds = m_verseCoordinates.at(verseIdxInPage);
 
-  m_highlighter->setPosition(bounds.first);
-  m_highlighter->setPosition(bounds.second, QTextCursor::KeepAnchor);
-  m_highlighter->mergeCharFormat(tcf);
+  highlight.cursor = QTextCursor(document());
+  highlight.cursor.setPosition(bounds.first);
+  highlight.cursor.setPosition(bounds.second, QTextCursor::KeepAnchor);
+  setExtraSelections({ highlight });
 
   m_highlightedIdx = verseIdxInPage;
 }
@@ -324,18 +501,40 @@ QuranPageBrowser::highlightVerse(int verseIdxInPage)
 void
 QuranPageBrowser::resetHighlight()
 {
-  QTextCharFormat tcf;
-  if (m_fgHighlight)
-    tcf.setForeground(m_config.darkMode() ? Qt::white : Qt::black);
-  else
-    tcf.setBackground(Qt::transparent);
-
-  if (m_highlighter->hasSelection())
-    m_highlighter->mergeCharFormat(tcf); // de-highlight any previous highlights
+  if (!extraSelections().isEmpty())
+    setExtraSelections({}); // de-highlight any previous highlights
 
   m_highlightedIdx = -1;
 }
 
+int
+QuranPageBrowser::verseIndexAt(int position) const
+{
+  // first verse ending after the position, verses are contiguous and sorted
+  auto it = std::upper_bound(
+    m_verseCoordinates.cbegin(),
+    m_verseCoordinates.cend(),
+    position,
+    [](int pos, const QPair<int, int>& bounds) { return pos < bounds.second; });
+
+  if (it == m_verseCoordinates.cend() || position < it->first)
+    return -1;
+
+  return static_cast<int>(std::distance(m_verseCoordinates.cbegin(), it));
+}
+
+int
+QuranPageBrowser::verseIndexAt(const QPoint& pos) const
+{
+  QPoint docPos = pos + QPoint(horizontalScrollBar()->value(),
+                               verticalScrollBar()->value());
+  int position = document()->documentLayout()->hitTest(docPos, Qt::ExactHit);
+  if (position < 0)
+    return -1;
+
+  return verseIndexAt(position);
+}
+
 QuranPageBrowser::Action
 QuranPageBrowser::lmbVerseMenu(bool favoriteVerse)
 {
@@ -380,17 +579,25 @@ QuranPageBrowser::lmbVerseMenu(bool favoriteVerse)
 int
 QuranPageBrowser::bestFitFontSize()
 {
-  int sz;
-  int margin = 10;
-  for (sz = 28; sz >= 12; sz--) {
-    QFontMetrics pageMetrics(QFont(m_pageFont, sz));
-    QFontMetrics headerMetrics(QFont("PakType Naskh Basic", sz - 6));
-    int pageHeight = (pageMetrics.height() * 15) + (headerMetrics.height() * 2);
-    if (pageHeight + margin <= parentWidget()->height())
-      break;
+  const int margin = 10;
+  const int available = parentWidget()->height() - margin;
+  auto pageHeight = [this](int sz) {
+    return (m_metricsCache.height(QFont(m_pageFont, sz)) * 15) +
+           (m_metricsCache.height(QFont("PakType Naskh Basic", sz - 6)) * 2);
+  };
+
+  // page height grows with the font size, binary search the largest size that
+  // fits in the available height
+  int lo = 12, hi = 28;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) / 2;
+    if (pageHeight(mid) <= available)
+      lo = mid;
+    else
+      hi = mid - 1;
   }
 
-  return sz;
+  return lo;
 }
 
 void
@@ -438,14 +645,57 @@ QuranPageBrowser::contextMenuEvent(QContextMenuEvent* event)
 }
 #endif // QT_NO_CONTEXTMENU
 
+void
+QuranPageBrowser::resizeEvent(QResizeEvent* event)
+{
+  QTextBrowser::resizeEvent(event);
+  m_resizeTimer.start();
+}
+
+void
+QuranPageBrowser::mouseMoveEvent(QMouseEvent* event)
+{
+  QTextBrowser::mouseMoveEvent(event);
+  if (!anchorAt(event->position().toPoint()).isEmpty())
+    return;
+
+  if (verseIndexAt(event->position().toPoint()) != -1)
+    viewport()->setCursor(Qt::PointingHandCursor);
+  else
+    viewport()->unsetCursor();
+}
+
+void
+QuranPageBrowser::mousePressEvent(QMouseEvent* event)
+{
+  QTextBrowser::mousePressEvent(event);
+  QPoint pos = event->position().toPoint();
+  m_pressedIdx = event->button() == Qt::LeftButton && anchorAt(pos).isEmpty()
+                   ? verseIndexAt(pos)
+                   : -1;
+}
+
+void
+QuranPageBrowser::mouseReleaseEvent(QMouseEvent* event)
+{
+  QTextBrowser::mouseReleaseEvent(event);
+  if (event->button() != Qt::LeftButton || m_pressedIdx == -1)
+    return;
+
+  int idx = verseIndexAt(event->position().toPoint());
+  bool sameVerse = idx == m_pressedIdx;
+  m_pressedIdx = -1;
+  if (sameVerse)
+    emit verseClicked(idx);
+}
+
 void
 QuranPageBrowser::actionZoomIn()
 {
   m_fontSize++;
   m_config.settings().setValue(
     "Reader/QCF" + QString::number(m_config.qcfVersion()) + "Size", m_fontSize);
-  constructPage(m_page, true);
-  highlightVerse(m_highlightedIdx);
+  restylePage(m_fontSize);
 }
 
 void
@@ -454,8 +704,20 @@ QuranPageBrowser::actionZoomOut()
   m_fontSize--;
   m_config.settings().setValue(
     "Reader/QCF" + QString::number(m_config.qcfVersion()) + "Size", m_fontSize);
-  constructPage(m_page, true);
-  highlightVerse(m_highlightedIdx);
+  restylePage(m_fontSize);
+}
+
+void
+QuranPageBrowser::adaptToSize()
+{
+  if (m_page < 1 || !m_config.settings().value("Reader/AdaptiveFont").toBool())
+    return;
+
+  // the adapted size is not written to the settings, it only follows the
+  // current widget size
+  int fontSize = bestFitFontSize();
+  if (fontSize != m_fontSize)
+    restylePage(fontSize);
 }
 
 void
@@ -493,3 +755,9 @@ QuranPageBrowser::page() const
 {
   return m_page;
 }
+
+int
+QuranPageBrowser::minimumPageWidth() const
+{
+  return m_pageLineSize.width() + 70;
+}
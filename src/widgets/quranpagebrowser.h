@@ -9,19 +9,23 @@
 #include <QContextMenuEvent>
 #include <QHBoxLayout>
 #include <QMenu>
+#include <QMouseEvent>
 #include <QPainter>
 #include <QPointer>
 #include <QPushButton>
+#include <QResizeEvent>
 #include <QScrollBar>
 #include <QSettings>
 #include <QShortcut>
 #include <QTextBrowser>
 #include <QTextCursor>
+#include <QTimer>
 #include <repository/glyphsrepository.h>
 #include <repository/quranrepository.h>
 #include <service/glyphservice.h>
 #include <service/quranservice.h>
 #include <utils/configuration.h>
+#include <utils/fontmetricscache.h>
 #include <utils/numbertostringconverter.h>
 #include <utils/stylemanager.h>
 
@@ -84,23 +88,74 @@ public:
    * (2) set the new page font, header, page lines and page line pixel size
    * (3) set minimum widget width to preseve the page display as expected
    * (4) insert page lines which could be ('frame', 'bsml' or normal line)
-   * (5) in case the line contains a verse end/separator (':'), carefully
-   * insert the glyphs and set the verse anchor tag href to '#N' where N is the
-   * verse number relative to the start of the page
-   * (6) set the start and end cursor positions for the verse
-   * (7) insert page footer with the page number
+   * without the verse end/separator (':') glyphs
+   * (5) load the start and end positions of the page verses, offset by the
+   * length of the header
+   * (6) insert page footer with the page number
    *
    * @param pageNo - page number to generate
    * @param forceCustomSize - boolean to force the use of
    */
   void constructPage(int pageNo, bool forceCustomSize = false);
+  /**
+   * @brief first step of constructPage, loads the page data from the
+   * services and computes the page font size and line size
+   * @details must be called from the GUI thread, database connections and
+   * font registration are bound to it
+   * @param pageNo - page number to prepare
+   * @param forceCustomSize - boolean to force the use of the manually set
+   * fontsize
+   */
+  void preparePage(int pageNo, bool forceCustomSize = false);
+  /**
+   * @brief second step of constructPage, builds the page document from the
+   * prepared page data
+   * @details only reads the page data prepared by preparePage and
+   * thread-safe caches, so documents of different browsers may be built
+   * concurrently in worker threads and the same prepared page may be built
+   * again. The returned document lives in the calling thread and must be
+   * moved to the thread of the widget before setPageDocument
+   * @return pointer to the new QTextDocument, ownership is passed to the
+   * caller until it is set with setPageDocument
+   */
+  QTextDocument* buildPageDocument();
+  /**
+   * @brief last step of constructPage, replace the displayed document with
+   * the built page document and position the verse bounds of the prepared
+   * page in it
+   * @param doc - document returned by buildPageDocument
+   */
+  void setPageDocument(QTextDocument* doc);
+  /**
+   * @brief change the font size of the displayed page without rebuilding the
+   * page document
+   * @details the body text format is changed in place, the surah frame and
+   * basmalah images are rescaled from the cached images and only the header
+   * and footer spacing is recomputed
+   * @param fontSize - the new page font size
+   */
+  void restylePage(int fontSize);
   /**
    * @brief highlight the specified verse in the displayed page
+   * @details the highlight is an extra selection painted over the page, only
+   * the region of the old and new verse is repainted and the document layout
+   * is left untouched
    * @param verseIdxInPage - 0-based index of the verse relative to the start of
    * the page
    */
   void highlightVerse(int verseIdxInPage);
+  /**
+   * @brief remove the highlight of the currently highlighted verse
+   */
   void resetHighlight();
+  /**
+   * @brief find the verse containing the given document position using a
+   * binary search over the page verse coordinates
+   * @param position - character position in the page document
+   * @return 0-based index of the verse relative to the start of the page, -1
+   * if the position is outside all verses
+   */
+  int verseIndexAt(int position) const;
   /**
    * @brief show the main verse interaction menu and return number related to
    * the chosen action
@@ -111,9 +166,18 @@ public:
   /**
    * @brief guess the best fontsize for the quran page based on the height of
    * the parent widget
+   * @details binary search over the cached line heights of the page font and
+   * header font
    * @return suggested fontsize for the page
    */
   int bestFitFontSize();
+  /**
+   * @brief generate QImage for the frame containing the surah name to insert in
+   * the page
+   * @param nameGlyph - QString of the surah name glyph
+   * @return QImage of the surah frame
+   */
+  QImage surahFrame(const QString& nameGlyph);
   /**
    * @brief getter for m_fontSize
    * @return fontsize for the current page
@@ -126,14 +190,20 @@ public:
   QString pageFont() const;
 
   int page() const;
+  /**
+   * @brief get the width needed to fit the longest line of the page, the
+   * owner of the browser decides whether to enforce it
+   * @return minimum width in pixels
+   */
+  int minimumPageWidth() const;
 
 public slots:
   /**
-   * @brief increment the fontsize by 1 and redraw the quran page
+   * @brief increment the fontsize by 1 and restyle the quran page
    */
   void actionZoomIn();
   /**
-   * @brief decrement the fontsize by 1 and redraw the quran page
+   * @brief decrement the fontsize by 1 and restyle the quran page
    */
   void actionZoomOut();
   /**
@@ -144,17 +214,43 @@ public slots:
 
 signals:
   void copyVerse(int IdxInPage);
+  /**
+   * @brief emitted when a verse in the page is clicked
+   * @param idxInPage - 0-based index of the verse relative to the start of the
+   * page
+   */
+  void verseClicked(int idxInPage);
+  /**
+   * @brief emitted when the page is constructed or restyled
+   * @param width - the new minimumPageWidth()
+   */
+  void minimumPageWidthChanged(int width);
+
+private slots:
+  /**
+   * @brief restyle the page with the best fitting font size when adaptive
+   * font size is enabled, called once resizing settles
+   */
+  void adaptToSize();
 
 protected:
 #ifndef QT_NO_CONTEXTMENU
   void contextMenuEvent(QContextMenuEvent* event) override;
 #endif
+  void resizeEvent(QResizeEvent* event) override;
+  void mouseMoveEvent(QMouseEvent* event) override;
+  void mousePressEvent(QMouseEvent* event) override;
+  void mouseReleaseEvent(QMouseEvent* event) override;
 
 private:
   Configuration& m_config;
   StyleManager& m_styleMgr;
   const QuranService* m_quranService;
   const GlyphService* m_glyphService;
+  /**
+   * @brief reference to the singleton FontMetricsCache used in page layout
+   */
+  FontMetricsCache& m_metricsCache;
   /**
    * @brief utility for creating menu actions for interacting with the widget
    */
@@ -166,12 +262,19 @@ private:
    */
   QSize calcPageLineSize(QStringList& lines);
   /**
-   * @brief generate QImage for the frame containing the surah name to insert in
-   * the page
-   * @param surah - surah number
-   * @return QImage of the surah frame
+   * @brief get the full size image for the given page image resource name,
+   * generated on first use and cached in m_pageImages
+   * @param name - "bsml" or the page line of the surah frame ("frame_surah")
+   * @return const reference to the cached image
+   */
+  const QImage& pageImage(const QString& name);
+  /**
+   * @brief add the page image scaled to the current page line width as a
+   * document resource under the given name
+   * @param doc - page document to add the resource to
+   * @param name - page image resource name
    */
-  QImage surahFrame(int surah);
+  void addPageImageResource(QTextDocument* doc, const QString& name);
   /**
    * @brief utility to set the href url for the text from the current cursor
    * position to the position given
@@ -182,8 +285,28 @@ private:
    */
   int setHref(QTextCursor* cursor, int to, QString url);
 
-  int insertHeader(QTextCursor*, int);
-  void insertFooter(QTextCursor*, int);
+  int insertHeader(QTextCursor*);
+  /**
+   * @brief set the header font size and space the header segments to fit the
+   * page line width
+   * @param page - page number of the header
+   * @return QString of the spaced header line
+   */
+  QString headerLine(int page);
+  void insertFooter(QTextCursor*);
+  /**
+   * @brief insert the footer segments at the cursor spaced to fit the page
+   * line width
+   * @param cursor - pointer to the QTextCursor positioned in the footer block
+   */
+  void fillFooter(QTextCursor* cursor);
+  /**
+   * @brief find the verse under the given viewport position
+   * @param pos - position relative to the widget viewport
+   * @return 0-based index of the verse relative to the start of the page, -1
+   * if no verse is under the position
+   */
+  int verseIndexAt(const QPoint& pos) const;
   /**
    * @brief boolean indicating whether to highlight the foreground of the active
    * verse or not
@@ -202,6 +325,10 @@ private:
    * page
    */
   int m_highlightedIdx = -1;
+  /**
+   * @brief 0-based index of the verse under the mouse when it was pressed
+   */
+  int m_pressedIdx = -1;
   /**
    * @brief the average size of the line in the current page
    */
@@ -271,10 +398,6 @@ private:
    * @brief QAction for bookmark removal functionality
    */
   QPointer<QAction> m_actRemBookmark;
-  /**
-   * @brief QTextCursor used in highlighting verses
-   */
-  QSharedPointer<QTextCursor> m_highlighter;
   /**
    * @brief page format properties used in inserting lines
    */
@@ -292,10 +415,51 @@ private:
    */
   QBrush m_highlightColor;
   /**
-   * @brief QList of integer arrays of start & end position for each verse in
-   * the current page
+   * @brief QList of [start, end) document positions for each verse in the
+   * current page, sorted by position
    */
   QList<QPair<int, int>> m_verseCoordinates;
+  /**
+   * @brief QList of [start, end) verse bounds of the prepared page, relative
+   * to the start of the page body
+   */
+  QList<QPair<int, int>> m_pageVerseBounds;
+  /**
+   * @brief document position of the prepared page body, the length of the
+   * header line
+   */
+  int m_bodyStart = 0;
+  /**
+   * @brief spaced header line of the prepared page
+   */
+  QString m_currHeaderLine;
+  /**
+   * @brief full size surah frame and basmalah images of the current page,
+   * keyed by their document resource name
+   */
+  QHash<QString, QImage> m_pageImages;
+  /**
+   * @brief surah name glyphs of the surah frames loaded so far, keyed by surah
+   * number
+   */
+  QHash<int, QString> m_surahNameGlyphs;
+  /**
+   * @brief default font of the page document, captured from the widget when
+   * the page is prepared
+   */
+  QFont m_documentFont;
+  /**
+   * @brief QBrush used for the secondary header & footer text
+   */
+  QBrush m_infoBrush;
+  /**
+   * @brief QBrush used for the page number in the footer
+   */
+  QBrush m_textBrush;
+  /**
+   * @brief single shot timer used to debounce resize events
+   */
+  QTimer m_resizeTimer;
   QPair<int, int> m_headerData;
   NumberToStringConverter m_stringConverter;
 };
@@ -0,0 +1,167 @@
+/**
+ * @file quranscrollview.cpp
+ * @brief Implementation file for QuranScrollView
+ */
+
+#include "quranscrollview.h"
+#include <QScrollBar>
+#include <algorithm>
+
+QuranScrollView::QuranScrollView(QWidget* parent, int initPage)
+  : QAbstractScrollArea(parent)
+  , m_currentPage(initPage)
+{
+  setFrameShape(QFrame::NoFrame);
+  setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+  setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+  viewport()->setStyleSheet("background: transparent;");
+
+  for (int i = 0; i < s_poolSize; i++) {
+    QuranPageBrowser* browser = new QuranPageBrowser(viewport(), initPage);
+    connect(browser,
+            &QuranPageBrowser::minimumPageWidthChanged,
+            this,
+            &QuranScrollView::updateMinimumWidth);
+    m_browsers.append(browser);
+  }
+  updateMinimumWidth();
+}
+
+QuranPageBrowser*
+QuranScrollView::pageBrowser(int page) const
+{
+  for (QuranPageBrowser* browser : m_browsers) {
+    if (browser->page() == page)
+      return browser;
+  }
+
+  return nullptr;
+}
+
+const QList<QuranPageBrowser*>&
+QuranScrollView::browsers() const
+{
+  return m_browsers;
+}
+
+int
+QuranScrollView::currentPage() const
+{
+  return m_currentPage;
+}
+
+void
+QuranScrollView::scrollToPage(int page)
+{
+  m_currentPage = page;
+  if (m_pageHeight > 0)
+    verticalScrollBar()->setValue((page - 1) * m_pageHeight);
+}
+
+void
+QuranScrollView::redrawPages(bool manualSz)
+{
+  for (QuranPageBrowser* browser : m_browsers) {
+    if (browser->page() > 0)
+      browser->constructPage(browser->page(), manualSz);
+  }
+}
+
+void
+QuranScrollView::updateScrollRange()
+{
+  verticalScrollBar()->setRange(0, 603 * m_pageHeight);
+  verticalScrollBar()->setPageStep(m_pageHeight);
+  verticalScrollBar()->setSingleStep(std::max(1, m_pageHeight / 20));
+}
+
+void
+QuranScrollView::updateMinimumWidth()
+{
+  int width = 0;
+  for (QuranPageBrowser* browser : m_browsers)
+    width = std::max(width, browser->minimumPageWidth());
+
+  setMinimumWidth(width + verticalScrollBar()->sizeHint().width());
+}
+
+void
+QuranScrollView::layoutPages()
+{
+  if (m_pageHeight <= 0)
+    return;
+
+  int offset = verticalScrollBar()->value();
+  int firstVisible = offset / m_pageHeight + 1;
+  int firstPooled = std::clamp(firstVisible - 1, 1, 605 - s_poolSize);
+  int lastPooled = firstPooled + s_poolSize - 1;
+
+  QList<QuranPageBrowser*> unused;
+  for (QuranPageBrowser* browser : m_browsers) {
+    if (browser->page() < firstPooled || browser->page() > lastPooled)
+      unused.append(browser);
+  }
+
+  // recycle the browsers that left the pool range
+  bool recycled = false;
+  for (int page = firstPooled; page <= lastPooled && !unused.isEmpty();
+       page++) {
+    if (pageBrowser(page))
+      continue;
+
+    QuranPageBrowser* browser = unused.takeFirst();
+    browser->setGeometry(0,
+                         (page - 1) * m_pageHeight - offset,
+                         viewport()->width(),
+                         m_pageHeight);
+    browser->constructPage(page);
+    recycled = true;
+  }
+
+  for (QuranPageBrowser* browser : m_browsers) {
+    browser->setGeometry(0,
+                         (browser->page() - 1) * m_pageHeight - offset,
+                         viewport()->width(),
+                         m_pageHeight);
+  }
+
+  if (recycled)
+    emit pagesRecycled();
+
+  int current =
+    std::clamp((offset + m_pageHeight / 2) / m_pageHeight + 1, 1, 604);
+  if (current != m_currentPage) {
+    m_currentPage = current;
+    emit currentPageChanged(current);
+  }
+}
+
+void
+QuranScrollView::scrollContentsBy(int dx, int dy)
+{
+  Q_UNUSED(dx);
+  Q_UNUSED(dy);
+  layoutPages();
+}
+
+void
+QuranScrollView::resizeEvent(QResizeEvent* event)
+{
+  QAbstractScrollArea::resizeEvent(event);
+  int oldHeight = m_pageHeight;
+  m_pageHeight = viewport()->height();
+  if (m_pageHeight <= 0 || m_pageHeight == oldHeight) {
+    layoutPages();
+    return;
+  }
+
+  // keep the current page at the top of the viewport
+  QSignalBlocker blocker(verticalScrollBar());
+  updateScrollRange();
+  verticalScrollBar()->setValue((m_currentPage - 1) * m_pageHeight);
+  blocker.unblock();
+
+  // pooled pages restyle themselves to fit the new height once resizing
+  // settles, see QuranPageBrowser::restylePage
+  layoutPages();
+}
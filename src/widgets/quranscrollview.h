@@ -0,0 +1,111 @@
+/**
+ * @file quranscrollview.h
+ * @brief Header file for QuranScrollView
+ */
+
+#ifndef QURANSCROLLVIEW_H
+#define QURANSCROLLVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QList>
+#include <QResizeEvent>
+#include <widgets/quranpagebrowser.h>
+
+/**
+ * @brief QuranScrollView class displays the mushaf as a continuous vertical
+ * strip of pages
+ * @details only a fixed pool of QuranPageBrowser widgets exists, placed around
+ * the visible part of the strip. A browser that scrolls out of the pool range
+ * is recycled and constructs the page that is approaching the viewport, so the
+ * memory used does not depend on the number of pages scrolled through
+ */
+class QuranScrollView : public QAbstractScrollArea
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief class constructor
+   * @param parent - pointer to parent widget
+   * @param initPage - page to show initially
+   */
+  explicit QuranScrollView(QWidget* parent = nullptr, int initPage = 1);
+  /**
+   * @brief get the browser currently displaying the given page
+   * @param page - page number
+   * @return pointer to the QuranPageBrowser, nullptr if the page is not in the
+   * pool
+   */
+  QuranPageBrowser* pageBrowser(int page) const;
+  /**
+   * @brief getter for m_browsers
+   * @return QList of the pooled QuranPageBrowser widgets
+   */
+  const QList<QuranPageBrowser*>& browsers() const;
+  /**
+   * @brief getter for m_currentPage
+   * @return the page occupying the middle of the viewport
+   */
+  int currentPage() const;
+  /**
+   * @brief scroll the strip so that the top of the given page is at the top
+   * of the viewport
+   * @param page - page number
+   */
+  void scrollToPage(int page);
+  /**
+   * @brief reconstruct the pages displayed by the pooled browsers
+   * @param manualSz - boolean flag to force the use of the manually set
+   * fontsize
+   */
+  void redrawPages(bool manualSz = false);
+
+signals:
+  /**
+   * @brief emitted when the page in the middle of the viewport changes
+   * @param page - the new current page
+   */
+  void currentPageChanged(int page);
+  /**
+   * @brief emitted after pooled browsers were assigned new pages
+   */
+  void pagesRecycled();
+
+protected:
+  void scrollContentsBy(int dx, int dy) override;
+  void resizeEvent(QResizeEvent* event) override;
+
+private:
+  /**
+   * @brief number of QuranPageBrowser widgets in the pool
+   */
+  static const int s_poolSize = 4;
+  /**
+   * @brief update the scroll range to fit the full strip of pages
+   */
+  void updateScrollRange();
+  /**
+   * @brief assign pages to the pooled browsers around the visible part of the
+   * strip and position them in the viewport
+   */
+  void layoutPages();
+  /**
+   * @brief fit the widest page line of the pooled browsers next to the
+   * scroll bar
+   */
+  void updateMinimumWidth();
+  /**
+   * @brief the pooled QuranPageBrowser widgets
+   */
+  QList<QuranPageBrowser*> m_browsers;
+  /**
+   * @brief height of a single page in the strip, equal to the viewport height
+   */
+  int m_pageHeight = 0;
+  /**
+   * @brief the page occupying the middle of the viewport
+   */
+  int m_currentPage;
+};
+
+#endif // QURANSCROLLVIEW_H